@@ -0,0 +1,141 @@
+/*
+  Benchmark - time every easing curve and Tween::seek() configuration
+
+  Prints one JSON object per line on Serial, so runs on different boards or
+  builds can be saved and compared:
+
+    {"name":"calc/CubicEaseIn/unsigned long,float","calls":256,"ns_per_call":1234,"calls_per_s":810372,"cycles_per_call":19744}
+
+  calc/... times the easing kernel for each explicitly instantiated Tween type,
+  seek/... times Tween::seek() without filters, with step filtering and with
+  increment filtering. fixed/... and float/... time the same 8 bit tween with
+  the fixed point kernel integer tweens use and with the float kernel it
+  replaces. cycles_per_call follows from F_CPU and is left out without it.
+
+  extras/HostBenchmark builds the same benchmark for the host with CMake.
+*/
+#include <tween.h>
+
+const unsigned int calls = 256;
+volatile float sink;
+
+const char* const curveNames[easingTypeCount] = {
+  "LinearEaseIn",  "LinearEaseOut",  "LinearEaseInOut",
+  "BackEaseIn",    "BackEaseOut",    "BackEaseInOut",
+  "BounceEaseIn",  "BounceEaseOut",  "BounceEaseInOut",
+  "CircEaseIn",    "CircEaseOut",    "CircEaseInOut",
+  "CubicEaseIn",   "CubicEaseOut",   "CubicEaseInOut",
+  "ElasticEaseIn", "ElasticEaseOut", "ElasticEaseInOut",
+  "ExpoEaseIn",    "ExpoEaseOut",    "ExpoEaseInOut",
+  "QuadEaseIn",    "QuadEaseOut",    "QuadEaseInOut",
+  "QuartEaseIn",   "QuartEaseOut",   "QuartEaseInOut",
+  "QuintEaseIn",   "QuintEaseOut",   "QuintEaseInOut",
+  "SineEaseIn",    "SineEaseOut",    "SineEaseInOut",
+  "ElasticEaseInFast", "ElasticEaseOutFast", "ElasticEaseInOutFast"
+};
+
+void report(const char* group, const char* what, const char* types, unsigned long elapsedUs) {
+  float ns = elapsedUs * 1000.0f / calls;
+  Serial.print(F("{\"name\":\""));
+  Serial.print(group);   Serial.print('/');
+  Serial.print(what);    Serial.print('/');
+  Serial.print(types);
+  Serial.print(F("\",\"calls\":"));       Serial.print(calls);
+  Serial.print(F(",\"ns_per_call\":"));   Serial.print(ns, 1);
+  Serial.print(F(",\"calls_per_s\":"));   Serial.print(ns > 0 ? 1e9f / ns : 0.0f, 0);
+#if defined(F_CPU)
+  Serial.print(F(",\"cycles_per_call\":")); Serial.print(ns * (F_CPU / 1e9f), 0);
+#endif
+  Serial.println('}');
+}
+
+template <class Tin, class Tout> void benchCalc(const char* types, Tout from, Tout to, Tin duration) {
+  for (unsigned char mode = 0; mode < easingTypeCount; mode++) {
+    float acc = 0;
+    unsigned long begin = micros();
+    for (unsigned int i = 0; i < calls; i++) {
+      Tin t = Tin((unsigned long)(i) * (unsigned long)(duration) / calls);
+      acc += easeRuntime::calc<Tin,Tout>(easingType(mode), t, from, Tout(to - from), duration);
+    }
+    unsigned long elapsed = micros() - begin;
+    sink = acc;
+    report("calc", curveNames[mode], types, elapsed);
+  }
+}
+
+// An 8 bit tween from 0 to 250 over 200 ticks, once on the fixed point kernel
+// that Tween<unsigned char, unsigned char> runs and once on the float kernel
+void benchFixed() {
+  for (unsigned char mode = 0; mode < easingTypeCount; mode++) {
+    unsigned int acc = 0;
+    unsigned long begin = micros();
+    for (unsigned int i = 0; i < calls; i++) {
+      unsigned char t = (unsigned char)(i * 200UL / calls);
+      acc += easeRuntime::calc<unsigned char, unsigned char>(easingType(mode), t, 0, 250, 200);
+    }
+    unsigned long elapsed = micros() - begin;
+    sink = acc;
+    report("fixed", curveNames[mode], "unsigned char,unsigned char", elapsed);
+
+    acc   = 0;
+    begin = micros();
+    for (unsigned int i = 0; i < calls; i++) {
+      unsigned char t = (unsigned char)(i * 200UL / calls);
+      acc += (unsigned char)(easeRuntime::calc<unsigned char, float>(easingType(mode), t, 0.0f, 250.0f, 200) + 0.5f);
+    }
+    elapsed = micros() - begin;
+    sink = acc;
+    report("float", curveNames[mode], "unsigned char,unsigned char", elapsed);
+  }
+}
+
+// Positions jump back and forth, so every seek() evaluates the curve in full
+template <class Tin, class Tout> void benchSeek(const char* what, const char* types, Tween<Tin,Tout>& tween, Tin duration) {
+  float acc = 0;
+  tween.startAt(0);
+  unsigned long begin = micros();
+  for (unsigned int i = 0; i < calls; i++) {
+    Tin t = Tin((unsigned long)((i * 7u) % calls) * (unsigned long)(duration) / calls);
+    tween.seek(t);
+    acc += tween.value();
+  }
+  unsigned long elapsed = micros() - begin;
+  sink = acc;
+  report("seek", what, types, elapsed);
+}
+
+template <class Tin, class Tout> void bench(const char* types, Tout from, Tout to, Tin duration) {
+  benchCalc<Tin,Tout>(types, from, to, duration);
+
+  Tween<Tin,Tout> plain, stepped, incremented;
+  plain.from(from).to(to).during(duration).easing(QuadEaseInOut);
+  stepped.from(from).to(to).during(duration).easing(QuadEaseInOut).step(Tin(duration / 16));
+  incremented.from(from).to(to).during(duration).easing(QuadEaseInOut).increment(Tout((to - from) / 16));
+  benchSeek<Tin,Tout>("plain",     types, plain,       duration);
+  benchSeek<Tin,Tout>("step",      types, stepped,     duration);
+  benchSeek<Tin,Tout>("increment", types, incremented, duration);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {}
+
+  bench<unsigned char,  char>         ("unsigned char,char",           0,   100,  200);
+  bench<unsigned char,  unsigned char>("unsigned char,unsigned char",  0,   250,  200);
+  bench<unsigned int,   int>          ("unsigned int,int",             -500, 500,  1000);
+  bench<unsigned int,   unsigned int> ("unsigned int,unsigned int",    0,   1000, 1000);
+  bench<unsigned long,  long>         ("unsigned long,long",           -50000L, 50000L, 10000UL);
+  bench<unsigned long,  unsigned long>("unsigned long,unsigned long",  0UL, 100000UL, 10000UL);
+  bench<unsigned long,  float>        ("unsigned long,float",          0.0f, 1.0f, 10000UL);
+  bench<float,          unsigned long>("float,unsigned long",          0UL, 100000UL, 1.0f);
+  bench<unsigned long,  double>       ("unsigned long,double",         0.0, 1.0, 10000UL);
+  bench<unsigned long long, float>   ("unsigned long long,float",     0.0f, 1.0f, 10000ULL);
+  bench<float,          float>        ("float,float",                  0.0f, 1.0f, 1.0f);
+  bench<double,         double>       ("double,double",                0.0, 1.0, 1.0);
+  benchFixed();
+
+  Serial.println(F("{\"done\":true}"));
+}
+
+void loop() {
+}
@@ -0,0 +1,53 @@
+// Host check of easeBatch against the scalar easing:: curves. Evaluates every
+// easingType in one batch over 1001 points of [0,d] and compares each value
+// with easeRuntime::calc. The batch curves must stay within 5e-7 of the scalar
+// ones, normalized to c; the *Fast elastic modes run the accurate batch
+// curves, so they are held to the 4e-4 the scalar *Fast curves are allowed.
+// Prints the largest error per curve and exits with the number of failed
+// curves.
+//
+//   g++ -O2 -std=c++11 -I../../src EaseBatchCheck.cpp -o EaseBatchCheck
+//   ./EaseBatchCheck
+
+#include <math.h>
+#include <stdio.h>
+#define TWEEN_INSTRUMENT                                                    // for easingName()
+#include "easebatch.h"
+#include "tweenstats.h"
+
+static const size_t samples = 1001;
+
+// Largest difference between batch and scalar over the samples, divided by |c|
+static float maxError(easingType mode, float b, float c, float d) {
+	float t[samples], bs[samples], cs[samples], ds[samples], out[samples];
+	for (size_t i = 0; i < samples; i++) {
+		t[i]  = d * float(i) / float(samples - 1);
+		bs[i] = b;
+		cs[i] = c;
+		ds[i] = d;
+	}
+	easeBatch::evaluate(mode, t, bs, cs, ds, out, samples);
+
+	float worst = 0;
+	for (size_t i = 0; i < samples; i++) {
+		float error = fabsf(out[i] - easeRuntime::calc<float,float>(mode, t[i], b, c, d)) / fabsf(c);
+		if (error > worst) worst = error;
+	}
+	return worst;
+}
+
+int main() {
+	unsigned int failures = 0;
+	for (unsigned char m = 0; m < easingTypeCount; m++) {
+		easingType mode  = easingType(m);
+		bool       fast  = mode == ElasticEaseInFast || mode == ElasticEaseOutFast || mode == ElasticEaseInOutFast;
+		float      bound = fast ? 4e-4f : 5e-7f;
+
+		float unit   = maxError(mode, 0, 1, 1);
+		float scaled = maxError(mode, 3, -7, 2.5f);
+		bool  ok     = unit <= bound && scaled <= bound;
+		printf("%s  %-22s max error %.2g, scaled %.2g\n", ok ? "ok  " : "FAIL", easingName(mode), unit, scaled);
+		if (!ok) failures++;
+	}
+	return int(failures);
+}
@@ -0,0 +1,82 @@
+// Host check of the fast trigonometry behind the *Fast elastic easings.
+// Measures sin16F and exp2F against libm over the arguments the elastic
+// curves pass them, and the normalized *Fast curves against the libm based
+// ones, holding each to the bound documented in ease.h. Then times every
+// *Fast curve against its libm counterpart. Prints one line per check and
+// per timing and exits with the number of failed checks.
+//
+//   g++ -O2 -std=c++11 -I../../src FastTrigCheck.cpp -o FastTrigCheck
+//   ./FastTrigCheck
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include "ease.h"
+
+typedef float (*curve)(float, float, float, float);
+
+static unsigned int failures = 0;
+static volatile float sink;
+
+static void check(const char* what, float error, float bound) {
+	bool ok = error <= bound;
+	printf("%s  %-44s max error %.2g, bound %.2g\n", ok ? "ok  " : "FAIL", what, error, bound);
+	if (!ok) failures++;
+}
+
+static float curveError(curve fast, curve exact) {
+	float worst = 0;
+	for (int i = 0; i <= 10000; i++) {
+		float x = i / 10000.f;
+		float e = fabsf(fast(x, 0, 1, 1) - exact(x, 0, 1, 1));
+		if (e > worst) worst = e;
+	}
+	return worst;
+}
+
+// Nanoseconds per call over a sweep of 1000 points, best of 20 runs
+static double nsPerCall(curve f) {
+	double best = 1e9;
+	for (int run = 0; run < 20; run++) {
+		float acc = 0;
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < 1000; i++) acc += f(i / 1000.f, 0, 1, 1);
+		double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / 1000;
+		sink = acc;
+		if (ns < best) best = ns;
+	}
+	return best;
+}
+
+int main() {
+	// elastic phases (x - s) * 2 pi / p cover about -16..20 for x in [0,1]
+	float worst = 0;
+	for (int i = -160000; i <= 200000; i++) {
+		float x = i / 10000.f;
+		float e = fabsf(easing::sin16F(x) - sinf(x));
+		if (e > worst) worst = e;
+	}
+	check("sin16F absolute, -16..20", worst, 5e-4f);
+
+	// elastic decays 2^(10 (x - 1)) and 2^(-10 x) cover -10..0
+	worst = 0;
+	for (int i = -100000; i <= 0; i++) {
+		float x = i / 10000.f;
+		float e = fabsf(easing::exp2F(x) / exp2f(x) - 1);
+		if (e > worst) worst = e;
+	}
+	check("exp2F relative, -10..0", worst, 6e-5f);
+
+	static const curve fast[]  = { easing::elasticEaseInFast<float,float>, easing::elasticEaseOutFast<float,float>, easing::elasticEaseInOutFast<float,float> };
+	static const curve exact[] = { easing::elasticEaseIn<float,float>,     easing::elasticEaseOut<float,float>,     easing::elasticEaseInOut<float,float> };
+	static const char* names[] = { "elasticEaseIn",                        "elasticEaseOut",                        "elasticEaseInOut" };
+	char what[64];
+	for (int k = 0; k < 3; k++) {
+		snprintf(what, sizeof(what), "%sFast against %s", names[k], names[k]);
+		check(what, curveError(fast[k], exact[k]), 4e-4f);
+	}
+	for (int k = 0; k < 3; k++) {
+		printf("time  %sFast %.1f ns, %s %.1f ns\n", names[k], nsPerCall(fast[k]), names[k], nsPerCall(exact[k]));
+	}
+	return int(failures);
+}
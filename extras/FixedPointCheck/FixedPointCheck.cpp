@@ -0,0 +1,62 @@
+// Host check of the fixed point easing kernels (easefixed.h). Evaluates every
+// easingType in Q14 at each of the 16385 normalized times and compares it with
+// the float kernel: elastic curves must stay within 1.5e-3 and the others
+// within 8e-4. An 8 bit tween over the full range must then stay within 1 of
+// the rounded float result, and so must a signed char tween, which also
+// covers signed time types. Prints the largest errors per curve and exits
+// with the number of failed curves.
+//
+//   g++ -O2 -std=c++11 -I../../src FixedPointCheck.cpp -o FixedPointCheck
+//   ./FixedPointCheck
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#define TWEEN_INSTRUMENT                                                    // for easingName()
+#include "ease.h"
+#include "tweenstats.h"
+
+static bool elastic(easingType mode) {
+	return mode == ElasticEaseIn     || mode == ElasticEaseOut     || mode == ElasticEaseInOut ||
+	       mode == ElasticEaseInFast || mode == ElasticEaseOutFast || mode == ElasticEaseInOutFast;
+}
+
+int main() {
+	unsigned int failures = 0;
+	for (unsigned char m = 0; m < easingTypeCount; m++) {
+		easingType mode = easingType(m);
+
+		// unsigned short in, short out takes the fixed point kernel; with t and
+		// d both in Q14 and c = 16384 it returns the normalized curve in Q14
+		float worst = 0;
+		for (int x = 0; x <= easingFixed::ONE; x++) {
+			float fixed = easeRuntime::calc<unsigned short, short>(mode, (unsigned short)x, 0, short(easingFixed::ONE), (unsigned short)easingFixed::ONE) / float(easingFixed::ONE);
+			float exact = easeRuntime::calc<float, float>(mode, float(x) / easingFixed::ONE, 0.f, 1.f, 1.f);
+			if (fabsf(fixed - exact) > worst) worst = fabsf(fixed - exact);
+		}
+
+		// unsigned char in and out: 0..255 over 255 ticks
+		int worst8 = 0;
+		for (int t = 0; t <= 255; t++) {
+			int fixed = easeRuntime::calc<unsigned char, unsigned char>(mode, (unsigned char)t, 0, 255, 255);
+			int exact = int(floorf(easeRuntime::calc<float, float>(mode, float(t), 0.f, 255.f, 255.f) + .5f));
+			if (exact < 0 || exact > 255) continue;                          // overshoot wraps in 8 bits either way
+			if (abs(fixed - exact) > worst8) worst8 = abs(fixed - exact);
+		}
+
+		// signed char in and out: 0..127 over 127 ticks
+		int worstSigned = 0;
+		for (int t = 0; t <= 127; t++) {
+			int fixed = easeRuntime::calc<signed char, signed char>(mode, (signed char)t, 0, 127, 127);
+			int exact = int(floorf(easeRuntime::calc<float, float>(mode, float(t), 0.f, 127.f, 127.f) + .5f));
+			if (exact < -128 || exact > 127) continue;
+			if (abs(fixed - exact) > worstSigned) worstSigned = abs(fixed - exact);
+		}
+
+		float bound = elastic(mode) ? 1.5e-3f : 8e-4f;
+		bool  ok    = worst <= bound && worst8 <= 1 && worstSigned <= 1;
+		printf("%s  %-22s max error %.2g, 8 bit %d, signed %d\n", ok ? "ok  " : "FAIL", easingName(mode), worst, worst8, worstSigned);
+		if (!ok) failures++;
+	}
+	return int(failures);
+}
@@ -0,0 +1,118 @@
+// Host build of examples/Benchmark: times every easing curve for each
+// explicitly instantiated Tween type and Tween::seek() without filters, with
+// step filtering and with increment filtering. Prints the same JSON lines as
+// the sketch, without cycles_per_call, so runs can be saved and compared:
+//
+//   {"name":"calc/CubicEaseIn/unsigned long,float","calls":65536,"ns_per_call":6.1,"calls_per_s":163934426}
+//
+//   cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build
+//   ./build/HostBenchmark [calls] > run.json
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#define TWEEN_INSTRUMENT                                                    // for easingName()
+#include "tween.h"
+#include "tweenstats.h"
+
+static unsigned long calls = 65536;
+static volatile float sink;
+
+static void report(const char* group, const char* what, const char* types, double seconds) {
+	double ns = seconds * 1e9 / calls;
+	printf("{\"name\":\"%s/%s/%s\",\"calls\":%lu,\"ns_per_call\":%.1f,\"calls_per_s\":%.0f}\n",
+	       group, what, types, calls, ns, ns > 0 ? 1e9 / ns : 0.0);
+}
+
+static double since(std::chrono::steady_clock::time_point begin) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+template <class Tin, class Tout> void benchCalc(const char* types, Tout from, Tout to, Tin duration) {
+	for (unsigned char mode = 0; mode < easingTypeCount; mode++) {
+		float acc = 0;
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		for (unsigned long i = 0; i < calls; i++) {
+			Tin t = Tin((unsigned long long)(i) * (unsigned long long)(duration) / calls);
+			acc += easeRuntime::calc<Tin,Tout>(easingType(mode), t, from, Tout(to - from), duration);
+		}
+		double elapsed = since(begin);
+		sink = acc;
+		report("calc", easingName(easingType(mode)), types, elapsed);
+	}
+}
+
+// An 8 bit tween from 0 to 250 over 200 ticks, once on the fixed point kernel
+// that Tween<unsigned char, unsigned char> runs and once on the float kernel
+static void benchFixed() {
+	for (unsigned char mode = 0; mode < easingTypeCount; mode++) {
+		unsigned int acc = 0;
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		for (unsigned long i = 0; i < calls; i++) {
+			unsigned char t = (unsigned char)(i * 200 / calls);
+			acc += easeRuntime::calc<unsigned char, unsigned char>(easingType(mode), t, 0, 250, 200);
+		}
+		double elapsed = since(begin);
+		sink = float(acc);
+		report("fixed", easingName(easingType(mode)), "unsigned char,unsigned char", elapsed);
+
+		acc   = 0;
+		begin = std::chrono::steady_clock::now();
+		for (unsigned long i = 0; i < calls; i++) {
+			unsigned char t = (unsigned char)(i * 200 / calls);
+			acc += (unsigned char)(easeRuntime::calc<unsigned char, float>(easingType(mode), t, 0.0f, 250.0f, 200) + 0.5f);
+		}
+		elapsed = since(begin);
+		sink = float(acc);
+		report("float", easingName(easingType(mode)), "unsigned char,unsigned char", elapsed);
+	}
+}
+
+// Positions jump back and forth, so every seek() evaluates the curve in full
+template <class Tin, class Tout> void benchSeek(const char* what, const char* types, Tween<Tin,Tout>& tween, Tin duration) {
+	float acc = 0;
+	tween.startAt(0);
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+	for (unsigned long i = 0; i < calls; i++) {
+		Tin t = Tin((unsigned long long)((i * 7) % calls) * (unsigned long long)(duration) / calls);
+		tween.seek(t);
+		acc += tween.value();
+	}
+	double elapsed = since(begin);
+	sink = acc;
+	report("seek", what, types, elapsed);
+}
+
+template <class Tin, class Tout> void bench(const char* types, Tout from, Tout to, Tin duration) {
+	benchCalc<Tin,Tout>(types, from, to, duration);
+
+	Tween<Tin,Tout> plain, stepped, incremented;
+	plain.from(from).to(to).during(duration).easing(QuadEaseInOut);
+	stepped.from(from).to(to).during(duration).easing(QuadEaseInOut).step(Tin(duration / 16));
+	incremented.from(from).to(to).during(duration).easing(QuadEaseInOut).increment(Tout((to - from) / 16));
+	benchSeek<Tin,Tout>("plain",     types, plain,       duration);
+	benchSeek<Tin,Tout>("step",      types, stepped,     duration);
+	benchSeek<Tin,Tout>("increment", types, incremented, duration);
+}
+
+int main(int argc, char** argv) {
+	if (argc > 1) calls = strtoul(argv[1], nullptr, 10);
+	if (calls == 0) calls = 1;
+
+	bench<unsigned char,      char>         ("unsigned char,char",           0,   100,  200);
+	bench<unsigned char,      unsigned char>("unsigned char,unsigned char",  0,   250,  200);
+	bench<unsigned int,       int>          ("unsigned int,int",             -500, 500,  1000);
+	bench<unsigned int,       unsigned int> ("unsigned int,unsigned int",    0,   1000, 1000);
+	bench<unsigned long,      long>         ("unsigned long,long",           -50000L, 50000L, 10000UL);
+	bench<unsigned long,      unsigned long>("unsigned long,unsigned long",  0UL, 100000UL, 10000UL);
+	bench<unsigned long,      float>        ("unsigned long,float",          0.0f, 1.0f, 10000UL);
+	bench<float,              unsigned long>("float,unsigned long",          0UL, 100000UL, 1.0f);
+	bench<unsigned long,      double>       ("unsigned long,double",         0.0, 1.0, 10000UL);
+	bench<unsigned long long, float>        ("unsigned long long,float",     0.0f, 1.0f, 10000ULL);
+	bench<float,              float>        ("float,float",                  0.0f, 1.0f, 1.0f);
+	bench<double,             double>       ("double,double",                0.0, 1.0, 1.0);
+	benchFixed();
+
+	printf("{\"done\":true}\n");
+	return 0;
+}
@@ -0,0 +1,73 @@
+// Host benchmark for keyframe playback: for shows of growing length, compares
+// the startup time of a memory mapped KeyframePlayer with building one Tween
+// per segment up front, and prints one JSON line per show length.
+//
+//   g++ -O2 -std=c++11 -I../../src KeyframeBenchmark.cpp -o KeyframeBenchmark
+//   ./KeyframeBenchmark [directory for the generated shows]
+
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "keyframes.h"
+
+typedef std::chrono::steady_clock benchClock;
+
+static double microsSince(benchClock::time_point begin) {
+	return std::chrono::duration<double, std::micro>(benchClock::now() - begin).count();
+}
+
+// Writes count keyframes 10 ms apart, cycling through the easings
+static bool writeShow(const std::string& path, uint32_t count) {
+	FILE* file = fopen(path.c_str(), "wb");
+	if (file == nullptr) return false;
+	uint8_t header[keyframeHeaderSize] = { 'T', 'W', 'K', 'F', keyframeVersion, KeyframeFloat, 0, 0,
+	                                       uint8_t(count), uint8_t(count >> 8), uint8_t(count >> 16), uint8_t(count >> 24) };
+	fwrite(header, 1, sizeof(header), file);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t time  = i * 10;
+		float    value = float(i % 256);
+		uint8_t  record[16] = { uint8_t(time), uint8_t(time >> 8), uint8_t(time >> 16), uint8_t(time >> 24), uint8_t(i % easingTypeCount) };
+		memcpy(record + 8, &value, 4);
+		fwrite(record, 1, sizeof(record), file);
+	}
+	return fclose(file) == 0;
+}
+
+int main(int argc, char** argv) {
+	std::string directory = argc > 1 ? argv[1] : "/tmp";
+
+	for (uint32_t count = 1000; count <= 1000000; count *= 10) {
+		std::string path = directory + "/KeyframeBenchmark.twkf";
+		if (!writeShow(path, count)) { fprintf(stderr, "cannot write %s\n", path.c_str()); return 1; }
+
+		// Lazy: map the file and load the first segment
+		benchClock::time_point begin = benchClock::now();
+		keyframeMap file(path.c_str());
+		KeyframePlayer<float, keyframeMap> show(file);
+		show.seek(5);
+		double lazy = microsSince(begin);
+
+		// Up front: one Tween per segment
+		begin = benchClock::now();
+		keyframeMap eager(path.c_str());
+		KeyframePlayer<float, keyframeMap> reader(eager);
+		std::vector< Tween<unsigned long, float> > tweens(count - 1);
+		KeyframePlayer<float, keyframeMap>::Keyframe from, to;
+		reader.keyframe(0, from);
+		for (uint32_t i = 0; i + 1 < count; i++) {
+			reader.keyframe(i + 1, to);
+			tweens[i].from(from.value).to(to.value).during(to.time - from.time).easing(from.easing).startAt(from.time);
+			from = to;
+		}
+		tweens[0].seek(5);
+		double upfront = microsSince(begin);
+
+		printf("{\"name\":\"Keyframes/startup\",\"keyframes\":%u,\"file_bytes\":%u,"
+		       "\"lazy_us\":%.1f,\"lazy_bytes\":%u,\"upfront_us\":%.1f,\"upfront_bytes\":%u}\n",
+		       count, unsigned(keyframeHeaderSize + 16 * count),
+		       lazy, unsigned(sizeof(show)), upfront, unsigned(sizeof(Tween<unsigned long, float>) * tweens.size()));
+		remove(path.c_str());
+	}
+	return 0;
+}
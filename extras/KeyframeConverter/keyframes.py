@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Converts keyframes from JSON or CSV into the binary format read by
+src/keyframes.h.
+
+  keyframes.py show.json show.twkf
+  keyframes.py show.csv show.twkf --format uint8
+
+JSON is either a list of keyframes or {"format": ..., "keyframes": [...]};
+each keyframe is {"time": ms, "value": v, "easing": "QuadEaseIn",
+"step": ms, "increment": v}. CSV has the columns time,value,easing,step,
+increment with a header row. Only time and value are required; easing
+defaults to LinearEaseIn. The easing of a keyframe applies to the segment
+towards the next keyframe.
+"""
+
+import argparse
+import csv
+import json
+import struct
+import sys
+
+# Same order as enum easingType in src/ease.h
+FAMILIES = ["Linear", "Back", "Bounce", "Circ", "Cubic", "Elastic",
+            "Expo", "Quad", "Quart", "Quint", "Sine"]
+EASINGS = [family + kind for family in FAMILIES for kind in ("EaseIn", "EaseOut", "EaseInOut")]
+EASINGS += ["ElasticEaseInFast", "ElasticEaseOutFast", "ElasticEaseInOutFast"]
+
+FORMATS = {            # code, struct format, range
+    "float": (0, "<f", None),
+    "int16": (1, "<h", (-32768, 32767)),
+    "uint8": (2, "<B", (0, 255)),
+}
+
+
+def easing_index(name):
+    if name in (None, ""):
+        return 0
+    if isinstance(name, int) or str(name).isdigit():
+        index = int(name)
+    elif name in EASINGS:
+        index = EASINGS.index(name)
+    else:
+        raise ValueError("unknown easing %r" % name)
+    if not 0 <= index < len(EASINGS):
+        raise ValueError("easing %r out of range" % name)
+    return index
+
+
+def read_keyframes(path):
+    if path.endswith(".csv"):
+        with open(path, newline="") as f:
+            return None, [row for row in csv.DictReader(f)]
+    with open(path) as f:
+        data = json.load(f)
+    if isinstance(data, dict):
+        return data.get("format"), data["keyframes"]
+    return None, data
+
+
+def encode_value(value, fmt):
+    code, pack, limits = FORMATS[fmt]
+    if limits is None:
+        return struct.pack(pack, float(value))
+    value = int(round(float(value)))
+    if not limits[0] <= value <= limits[1]:
+        raise ValueError("value %d does not fit %s" % (value, fmt))
+    return struct.pack(pack, value)
+
+
+def convert(keyframes, fmt):
+    out = bytearray(b"TWKF")
+    out += struct.pack("<BBHI", 1, FORMATS[fmt][0], 0, len(keyframes))
+    previous = 0
+    for number, key in enumerate(keyframes):
+        time = int(key["time"])
+        if time < previous or time > 0xFFFFFFFF:
+            raise ValueError("keyframe %d: time %d is out of order" % (number, time))
+        previous = time
+        step = int(key.get("step") or 0)
+        if not 0 <= step <= 0xFFFF:
+            raise ValueError("keyframe %d: step %d does not fit 16 bits" % (number, step))
+        out += struct.pack("<IBBH", time, easing_index(key.get("easing")), 0, step)
+        out += encode_value(key["value"], fmt)
+        out += encode_value(key.get("increment") or 0, fmt)
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert JSON or CSV keyframes to a binary keyframe file")
+    parser.add_argument("input")
+    parser.add_argument("output")
+    parser.add_argument("--format", choices=sorted(FORMATS), help="value format (default: from the file, else float)")
+    args = parser.parse_args()
+
+    fmt, keyframes = read_keyframes(args.input)
+    fmt = args.format or fmt or "float"
+    try:
+        data = convert(keyframes, fmt)
+    except (KeyError, ValueError) as error:
+        sys.exit("%s: %s" % (args.input, error))
+    with open(args.output, "wb") as f:
+        f.write(data)
+    print("%s: %d keyframes, %d bytes" % (args.output, len(keyframes), len(data)))
+
+
+if __name__ == "__main__":
+    main()
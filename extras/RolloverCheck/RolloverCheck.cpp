@@ -0,0 +1,127 @@
+// Host check of timed tweens across clock wrap around. Drives the tweens from
+// simulated 32-bit millis() and micros() clocks that wrap during the ramp, and
+// a 64-bit extended clock over several wraps, and compares every value with
+// the linear ramp it should follow. Prints one line per scenario and exits
+// with the number of failed scenarios.
+//
+//   g++ -O2 -std=c++11 -I../../src RolloverCheck.cpp -o RolloverCheck
+//   ./RolloverCheck
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "tween.h"
+#include "tweenpool.h"
+#include "scheduler.h"
+
+typedef clockFrame<1000>              simMillis;                           // millis() of a 32-bit core
+typedef clockFrame<1>                 simMicros;                           // micros() of a 32-bit core
+typedef clockExtended<simMillis, 32>  simMillis64;
+
+static const unsigned long long wrap = 1ULL << 32;
+static unsigned int failures = 0;
+
+static void report(const char* scenario, bool ok, unsigned long long at, float value, float expected) {
+	if (ok) printf("ok    %s\n", scenario);
+	else    printf("FAIL  %s: at %llu value %g, expected %g\n", scenario, at, value, expected);
+	if (!ok) failures++;
+}
+
+// Runs tween from 0 to 100 from start for duration ticks of Clock, reading
+// the clock every step ticks until past the end. Clock reads the low 32 bits
+// of the simulated time
+template <class TweenT> void ramp(const char* scenario, TweenT& tween, unsigned long long start, unsigned long long duration, unsigned long long step) {
+	typedef typename TweenT::clockType clock;
+	clockFrame<clock::usecPerTick>::set((unsigned long)uint32_t(start));
+	tween.from(0).to(100).easing(LinearEaseInOut).start();
+
+	for (unsigned long long t = start; t <= start + duration + step; t += step) {
+		clockFrame<clock::usecPerTick>::set((unsigned long)uint32_t(t));
+		tween.update();
+		bool  ended    = t > start + duration;
+		float expected = ended ? 100 : float(double(t - start) * 100 / double(duration));
+		if (fabs(tween.value() - expected) > 1e-3f || tween.isAnimating() == ended) {
+			report(scenario, false, t, tween.value(), expected);
+			return;
+		}
+	}
+	report(scenario, true, 0, 0, 0);
+}
+
+int main() {
+	Tween<uint32_t, float, easeRuntime, simMillis> seconds;
+	seconds.duringSec(10);
+	ramp("10 s in 100 ms steps across the millis() wrap", seconds, wrap - 5000, 10000, 100);
+
+	Tween<uint32_t, float, easeRuntime, simMillis> week;
+	week.duringWeek(1);
+	report("duringWeek(1) is 604800000 ms", week.length() == 604800000UL, 0, float(week.length()), 604800000.f);
+	ramp("one week in hourly steps across the millis() wrap", week, wrap - 3 * 86400000ULL, 604800000ULL, 3600000ULL);
+
+	Tween<uint32_t, float, easeRuntime, simMillis> days;
+	days.duringDay(40);
+	report("duringDay(40) does not overflow 32 bits", days.length() == 3456000000UL, 0, float(days.length()), 3456000000.f);
+	ramp("40 days, over half the clock range, in hourly steps to the end", days, wrap - 10 * 86400000ULL, 3456000000ULL, 3600000ULL);
+
+	Tween<uint32_t, float, easeRuntime, simMicros> minutes;
+	minutes.duringMin(10);
+	ramp("10 min in 1 s steps across the micros() wrap", minutes, wrap - 60000000ULL, 600000000ULL, 1000000ULL);
+
+	// 120 days on the extended clock span two wraps of the 32-bit millis()
+	Tween<unsigned long long, float, easeRuntime, simMillis64> season;
+	season.duringDay(120);
+	simMillis::set((unsigned long)uint32_t(wrap - 86400000ULL));
+	season.from(0).to(100).easing(LinearEaseInOut).start();
+	bool ok = true;
+	unsigned long long at = 0;
+	float expected = 0;
+	for (unsigned long long h = 0; h <= 120 * 24 && ok; h++) {
+		at = wrap - 86400000ULL + h * 3600000ULL;
+		simMillis::set((unsigned long)uint32_t(at));
+		season.update();
+		expected = float(double(h) * 100 / (120 * 24));
+		ok = fabs(season.value() - expected) < 1e-3f;
+	}
+	report("120 days on the 64-bit extended clock", ok, at, season.value(), expected);
+
+	TweenPool<uint32_t, float, 2> pool;
+	pool.add().from(0).to(100).during(10000).easing(LinearEaseInOut).start(uint32_t(wrap - 5000));
+	ok = true;
+	for (unsigned long long t = wrap - 5000; t <= wrap + 5000 && ok; t += 100) {
+		pool.updateAll(uint32_t(t));
+		expected = float(double(t - (wrap - 5000)) * 100 / 10000);
+		ok = fabs(pool[0].value() - expected) < 1e-3f;
+		at = t;
+	}
+	report("TweenPool across the wrap", ok && !pool[0].isAnimating(), at, pool[0].value(), expected);
+
+	pool.add().from(0).to(100).during(3456000000UL).easing(LinearEaseInOut).start(uint32_t(wrap - 86400000ULL));
+	ok = true;
+	for (unsigned long long h = 0; h <= 40 * 24 && ok; h++) {
+		at = wrap - 86400000ULL + h * 3600000ULL;
+		pool.updateAll(uint32_t(at));
+		expected = float(double(h) * 100 / (40 * 24));
+		ok = fabs(pool[1].value() - expected) < 1e-3f;
+	}
+	report("TweenPool plays 40 days to the end", ok && !pool[1].isAnimating(), at, pool[1].value(), expected);
+
+	// Retargeted after 20 days without an update, then next updated 26 days
+	// later, past the end and over half the clock range after the new start
+	TweenPool<uint32_t, float, 1> retargeted;
+	retargeted.add().from(0).to(100).during(3456000000UL).easing(LinearEaseInOut).start(uint32_t(wrap - 86400000ULL));
+	float targets[1] = { 200 };
+	retargeted.retargetAll(uint32_t(wrap - 86400000ULL + 20 * 86400000ULL), targets);
+	at = wrap - 86400000ULL + 46 * 86400000ULL;
+	retargeted.updateAll(uint32_t(at));
+	report("TweenPool retargeted before its first update ends on the new target", retargeted[0].value() == 200 && !retargeted[0].isAnimating(), at, retargeted[0].value(), 200);
+
+	TweenScheduler<uint32_t, float> scheduler;
+	Tween<uint32_t, float> stepped;
+	stepped.from(0).to(100).duringSec(10).stepSec(1).easing(LinearEaseInOut).startAt(uint32_t(wrap - 5000));
+	scheduler.add(stepped);
+	unsigned int updates = 0;
+	for (unsigned long long t = wrap - 5000; t <= wrap + 6000; t += 100) updates += scheduler.poll(uint32_t(t));
+	report("TweenScheduler steps across the wrap", updates == 11 && stepped.value() == 100, updates, stepped.value(), 100);
+
+	return int(failures);
+}
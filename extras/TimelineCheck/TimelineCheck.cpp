@@ -0,0 +1,87 @@
+// Host check of Timeline::seek(). Plays a timeline with coarse frames that jump
+// past segment ends, scrubs it back and forth, and seeks around a long segment
+// that overlaps many short ones, comparing every segment value with the one it
+// should have settled to. Prints one line per scenario and exits with the
+// number of failed scenarios.
+//
+//   g++ -O2 -std=c++11 -I../../src TimelineCheck.cpp -o TimelineCheck
+//   ./TimelineCheck
+
+#include <math.h>
+#include <stdio.h>
+#include "timeline.h"
+
+typedef Tween<unsigned int, float>        TweenType;
+typedef Timeline<unsigned int, float, 64> TimelineType;
+
+static unsigned int failures = 0;
+
+static bool near(float value, float expected) {
+	return fabs(value - expected) < 1e-3f;
+}
+
+static void report(const char* scenario, bool ok, unsigned int at, float value, float expected) {
+	if (ok) printf("ok    %s\n", scenario);
+	else    printf("FAIL  %s: at %u value %g, expected %g\n", scenario, at, value, expected);
+	if (!ok) failures++;
+}
+
+int main() {
+	TweenType a, b;
+	a.from(0).to(100).during(100).easing(LinearEaseInOut);
+	b.from(0).to(50).during(50).easing(LinearEaseInOut);
+	TimelineType show;
+	show.then(a).then(b);
+
+	// 33 ms frames never land on 100 or 150
+	unsigned int t = 0;
+	for (; t <= 200; t += 33) show.seek(t);
+	report("frames jumping past the ends settle a", near(a.value(), 100), t, a.value(), 100);
+	report("frames jumping past the ends settle b", near(b.value(), 50), t, b.value(), 50);
+
+	show.seek(125);
+	show.seek(10);
+	report("scrubbing back sets a", near(a.value(), 10), 10, a.value(), 10);
+	report("scrubbing back settles b to its start", near(b.value(), 0), 10, b.value(), 0);
+
+	show.seek(500);
+	report("jumping forward again settles b", near(b.value(), 50), 500, b.value(), 50);
+
+	// One segment spanning the whole timeline, many short ones after each other
+	TweenType  all, steps[32];
+	TimelineType track;
+	all.from(0).to(1000).during(3200).easing(LinearEaseInOut);
+	track.add(all, 0);
+	for (unsigned int i = 0; i < 32; i++) {
+		steps[i].from(0).to(1).during(100).easing(LinearEaseInOut);
+		track.add(steps[i], i * 100);
+	}
+
+	bool  ok       = true;
+	float value    = 0;
+	float expected = 0;
+	for (t = 0; t <= 3300 && ok; t += 70) {
+		track.seek(t);
+		for (unsigned int i = 0; i < 32 && i * 100 <= t && ok; i++) {            // the later ones were not reached yet
+			unsigned int start = i * 100;
+			expected = t <= start ? 0 : t >= start + 100 ? 1 : float(t - start) / 100;
+			value    = steps[i].value();
+			ok       = near(value, expected);
+		}
+		if (ok) { value = all.value(); expected = t >= 3200 ? 1000 : float(t) * 1000 / 3200; ok = near(value, expected); }
+	}
+	report("short segments under a long one", ok, t, value, expected);
+
+	for (t = 3300; t > 0 && ok; t -= 130) {
+		track.seek(t);
+		for (unsigned int i = 0; i < 32 && ok; i++) {
+			unsigned int start = i * 100;
+			expected = t <= start ? 0 : t >= start + 100 ? 1 : float(t - start) / 100;
+			value    = steps[i].value();
+			ok       = near(value, expected);
+		}
+	}
+	report("scrubbing back over the short segments", ok, t, value, expected);
+
+	return int(failures);
+}
@@ -0,0 +1,40 @@
+// Host benchmark for TweenWorld: advances the same set of tweens with 1..N
+// threads and prints one JSON line per thread count.
+//
+//   g++ -O2 -std=c++11 -pthread -I../../src WorldBenchmark.cpp -o WorldBenchmark
+//   ./WorldBenchmark [channels] [frames]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include "tweenworld.h"
+
+static const easingType curves[] = {
+	LinearEaseInOut, QuadEaseInOut, CubicEaseInOut, SineEaseInOut, ElasticEaseOut, BounceEaseOut,
+};
+
+int main(int argc, char** argv) {
+	unsigned int channels = argc > 1 ? atoi(argv[1]) : 100000;
+	unsigned int frames   = argc > 2 ? atoi(argv[2]) : 200;
+	unsigned int cores    = std::thread::hardware_concurrency();
+	if (cores == 0) cores = 1;
+
+	double single = 0;
+	for (unsigned int threads = 1; threads <= cores; threads++) {
+		TweenWorld<double, float> world(channels, threads);
+		for (unsigned int i = 0; i < channels; i++) {
+			world.add().from(0).to(1000).during(frames + i % 97).easing(curves[i % (sizeof(curves) / sizeof(curves[0]))]).start(0);
+		}
+
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+		for (unsigned int f = 1; f <= frames; f++) world.advance(f);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		double updates = double(channels) * frames;
+		if (threads == 1) single = seconds;
+		printf("{\"name\":\"TweenWorld/advance\",\"threads\":%u,\"channels\":%u,\"frames\":%u,"
+		       "\"ns_per_update\":%.2f,\"updates_per_s\":%.0f,\"speedup\":%.2f}\n",
+		       threads, channels, frames, seconds * 1e9 / updates, updates / seconds, single / seconds);
+	}
+	return 0;
+}
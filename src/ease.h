@@ -27,6 +27,9 @@
 #pragma once
 
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "easefixed.h"
 
 #ifndef PI
 #define PI      3.14159265
@@ -52,6 +55,41 @@ public:
 #pragma warning( disable : 4244)
 
 
+	/*-----------------------------
+	  FAST TRIGONOMETRY
+	-----------------------------*/
+	// Used by the *Fast elastic easings. Measured against libm over the range the
+	// elastic curves use: sin16F absolute error below 5e-4, exp2F relative error
+	// below 6e-5, so the normalized *Fast curves stay within 4e-4 of the libm
+	// based ones. On an x86-64 host (gcc -O2) elasticEaseOutFast takes 16 ns per
+	// call against 41 ns for elasticEaseOut. extras/FastTrigCheck checks these
+	// bounds and repeats the timing.
+
+	// Sine with a 16 bit phase: x is wrapped to one turn in 65536 steps, folded
+	// to a quarter wave and evaluated with a 5th order polynomial in Q15 integer
+	// arithmetic. Valid for |x| < 200000
+	static float sin16F(float x) {
+		unsigned short phase = (unsigned short)(long(x * 10430.378f));       // 65536 / (2 pi)
+		long           z     = long(phase & 0x3FFF) << 1;                   // position in quadrant, Q15
+		if (phase & 0x4000) z = 32768 - z;
+		long z2 = (z * z) >> 15;
+		long y  = (z * (51472 - ((z2 * (21024 - ((z2 * 2320) >> 15))) >> 15))) >> 15;
+		return (phase & 0x8000) ? y * (-1.0f / 32768) : y * (1.0f / 32768);
+	}
+
+	// 2^x for -126 < x < 128: exponent set directly from the integer part,
+	// 4th order polynomial for the fraction in [-0.5,0.5]
+	static float exp2F(float x) {
+		if (x < -125) return 0;
+		long  n = long(x + 128.5f) - 128;
+		float f = x - n;
+		float p = 1 + f*(0.6931472f + f*(0.2402265f + f*(0.0555041f + f*0.0096181f)));
+		int32_t e = int32_t(n + 127) << 23;
+		float s;
+		memcpy(&s, &e, sizeof(s));
+		return p * s;
+	}
+
 	template <typename Ti, typename To> static To linearEaseIn(Ti tin, To b, To c, Ti d) {
 		float t = float(tin);
 		return c * t / d + b;
@@ -186,35 +224,38 @@ public:
 
 	template <typename Ti, typename To> static To elasticEaseInFast(Ti tin, To b, To c, Ti d) {
 		float t = float(tin);
-		if (t == 0) return b;  if ((t /= d) == 1) return b + c;
+		if (t == 0) return b;
+		if ((t /= d) == 1) return b + c;
 		float p = d * .3f;
 		float a = c;
 		float s = p / 4;
-		float postFix = a * pow(2, 10 * (t -= 1)); // this is a fix, again, with post-increment operators
+		float postFix = a * exp2F(10 * (t -= 1)); // this is a fix, again, with post-increment operators
 		return -(postFix * sin16F((t*d - s)*(TWO_PI) / p)) + b;
 	}
 
 	template <typename Ti, typename To> static To elasticEaseOutFast(Ti tin, To b, To c, Ti d) {
 		float t = float(tin);
-		if (t == 0) return b;  if ((t /= d) == 1) return b + c;
+		if (t == 0) return b;
+		if ((t /= d) == 1) return b + c;
 		float p = d * .3f;
 		float a = c;
 		float s = p / 4;
-		return (a*pow(2, -10 * t) * sin16F((t*d - s)*(TWO_PI) / p) + c + b);
+		return (a*exp2F(-10 * t) * sin16F((t*d - s)*(TWO_PI) / p) + c + b);
 	}
 
 	template <typename Ti, typename To> static To elasticEaseInOutFast(Ti tin, To b, To c, Ti d) {
 		float t = float(tin);
-		if (t == 0) return b;  if ((t /= d / 2) == 2) return b + c;
+		if (t == 0) return b;
+		if ((t /= d / 2) == 2) return b + c;
 		float p = d * (.3f*1.5f);
 		float a = c;
 		float s = p / 4;
 
 		if (t < 1) {
-			float postFix = a * pow(2, 10 * (t -= 1)); // postIncrement is evil
+			float postFix = a * exp2F(10 * (t -= 1)); // postIncrement is evil
 			return -.5f*(postFix* sin16F((t*d - s)*(TWO_PI) / p)) + b;
 		}
-		float postFix = a * pow(2, -10 * (t -= 1)); // postIncrement is evil
+		float postFix = a * exp2F(-10 * (t -= 1)); // postIncrement is evil
 		return postFix * sin16F((t*d - s)*(TWO_PI) / p)*.5f + c + b;
 	}
 
@@ -249,7 +290,8 @@ public:
 	template <typename Ti, typename To> static To quadEaseInOut(Ti tin, To b, To c, Ti d) {
 		float t = float(tin);
 		if ((t /= d / 2) < 1) return ((c / 2)*(t*t)) + b;
-		return -c / 2 * (((t - 2)*(--t)) - 1) + b;
+		t -= 1;
+		return -c / 2 * ((t*(t - 2)) - 1) + b;
 	}
 
 	template <typename Ti, typename To> static To quartEaseIn(Ti tin, To b, To c, Ti d) {
@@ -298,4 +340,205 @@ public:
 		return -c / 2 * (cos(PI*t / d) - 1) + b;
 	}
 
-};
\ No newline at end of file
+};
+
+/*-----------------------------
+  EASING SELECTION
+-----------------------------*/
+
+#define Ease(EASEMETHOD)  EASEMETHOD ## EaseIn, EASEMETHOD ## EaseOut, EASEMETHOD ## EaseInOut
+
+enum easingType {
+	Ease(Linear),
+	Ease(Back),
+	Ease(Bounce),
+	Ease(Circ),
+	Ease(Cubic),
+	Ease(Elastic),
+	Ease(Expo),
+	Ease(Quad),
+	Ease(Quart),
+	Ease(Quint),
+	Ease(Sine),
+	ElasticEaseInFast, ElasticEaseOutFast, ElasticEaseInOutFast
+};
+
+// Number of easingType values, for tables indexed by easing type
+const unsigned char easingTypeCount = ElasticEaseInOutFast + 1;
+
+// Integer types small enough for the fixed point kernels in easefixed.h
+template <typename T> struct easeFixedType         { static const bool value = false; };
+template <> struct easeFixedType<char>             { static const bool value = true;  };
+template <> struct easeFixedType<signed char>      { static const bool value = true;  };
+template <> struct easeFixedType<unsigned char>    { static const bool value = true;  };
+template <> struct easeFixedType<short>            { static const bool value = true;  };
+template <> struct easeFixedType<unsigned short>   { static const bool value = true;  };
+template <> struct easeFixedType<int>              { static const bool value = sizeof(int) <= 2; };
+template <> struct easeFixedType<unsigned int>     { static const bool value = sizeof(int) <= 2; };
+template <> struct easeFixedType<long>             { static const bool value = false; };
+template <> struct easeFixedType<unsigned long>    { static const bool value = false; };
+
+template <typename T> struct easeIntegerType       { static const bool value = easeFixedType<T>::value; };
+template <> struct easeIntegerType<int>            { static const bool value = true;  };
+template <> struct easeIntegerType<unsigned int>   { static const bool value = true;  };
+template <> struct easeIntegerType<long>           { static const bool value = true;  };
+template <> struct easeIntegerType<unsigned long>  { static const bool value = true;  };
+
+// Picks the float kernel, or the fixed point one when Ti is integral and To an 8 or
+// 16 bit integer. Wider outputs need more precision than Q14 and stay on float.
+template <typename Ti, typename To, bool Fixed = easeIntegerType<Ti>::value && easeFixedType<To>::value> struct easeKernel {
+	template <To (*Kernel)(Ti, To, To, Ti), int32_t (*Q14)(int32_t)> static To calc(Ti t, To b, To c, Ti d) { return Kernel(t, b, c, d); }
+};
+
+template <typename Ti, typename To> struct easeKernel<Ti, To, true> {
+	template <To (*Kernel)(Ti, To, To, Ti), int32_t (*Q14)(int32_t)> static To calc(Ti t, To b, To c, Ti d) { return easingFixed::apply<Ti, To>(Q14, t, b, c, d); }
+};
+
+// Curve policies share one signature: calc(mode, t, b, c, d). easeCurve<E> ignores
+// mode and calls a single kernel so it can be inlined, easeRuntime switches on mode.
+template <easingType E> struct easeCurve;
+
+#define EaseCurve(MODE, METHOD) \
+	template <> struct easeCurve<MODE> { \
+		static const easingType mode = MODE; \
+		template <typename Ti, typename To> static To calc(easingType, Ti t, To b, To c, Ti d) { \
+			return easeKernel<Ti, To>::template calc<&easing::METHOD<Ti, To>, &easingFixed::METHOD>(t, b, c, d); \
+		} \
+	};
+
+#define EaseCurves(EASEMETHOD, easemethod) \
+	EaseCurve(EASEMETHOD ## EaseIn,    easemethod ## EaseIn) \
+	EaseCurve(EASEMETHOD ## EaseOut,   easemethod ## EaseOut) \
+	EaseCurve(EASEMETHOD ## EaseInOut, easemethod ## EaseInOut)
+
+EaseCurves(Linear,  linear)
+EaseCurves(Back,    back)
+EaseCurves(Bounce,  bounce)
+EaseCurves(Circ,    circ)
+EaseCurves(Cubic,   cubic)
+EaseCurves(Elastic, elastic)
+EaseCurves(Expo,    expo)
+EaseCurves(Quad,    quad)
+EaseCurves(Quart,   quart)
+EaseCurves(Quint,   quint)
+EaseCurves(Sine,    sine)
+EaseCurve(ElasticEaseInFast,    elasticEaseInFast)
+EaseCurve(ElasticEaseOutFast,   elasticEaseOutFast)
+EaseCurve(ElasticEaseInOutFast, elasticEaseInOutFast)
+
+struct easeRuntime {
+	static const easingType mode = LinearEaseIn;
+
+	template <typename Ti, typename To> static To calc(easingType easeMode, Ti t, To b, To c, Ti d) {
+		switch (easeMode) {
+			default:
+			case LinearEaseIn:         return easeCurve<LinearEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case LinearEaseOut:        return easeCurve<LinearEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case LinearEaseInOut:      return easeCurve<LinearEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case BackEaseIn:           return easeCurve<BackEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case BackEaseOut:          return easeCurve<BackEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case BackEaseInOut:        return easeCurve<BackEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case BounceEaseIn:         return easeCurve<BounceEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case BounceEaseOut:        return easeCurve<BounceEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case BounceEaseInOut:      return easeCurve<BounceEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case CircEaseIn:           return easeCurve<CircEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case CircEaseOut:          return easeCurve<CircEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case CircEaseInOut:        return easeCurve<CircEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case CubicEaseIn:          return easeCurve<CubicEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case CubicEaseOut:         return easeCurve<CubicEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case CubicEaseInOut:       return easeCurve<CubicEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case ElasticEaseIn:        return easeCurve<ElasticEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case ElasticEaseOut:       return easeCurve<ElasticEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case ElasticEaseInOut:     return easeCurve<ElasticEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case ExpoEaseIn:           return easeCurve<ExpoEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case ExpoEaseOut:          return easeCurve<ExpoEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case ExpoEaseInOut:        return easeCurve<ExpoEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case QuadEaseIn:           return easeCurve<QuadEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case QuadEaseOut:          return easeCurve<QuadEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case QuadEaseInOut:        return easeCurve<QuadEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case QuartEaseIn:          return easeCurve<QuartEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case QuartEaseOut:         return easeCurve<QuartEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case QuartEaseInOut:       return easeCurve<QuartEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case QuintEaseIn:          return easeCurve<QuintEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case QuintEaseOut:         return easeCurve<QuintEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case QuintEaseInOut:       return easeCurve<QuintEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case SineEaseIn:           return easeCurve<SineEaseIn>::calc<Ti,To>(easeMode,t,b,c,d);
+			case SineEaseOut:          return easeCurve<SineEaseOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case SineEaseInOut:        return easeCurve<SineEaseInOut>::calc<Ti,To>(easeMode,t,b,c,d);
+			case ElasticEaseInFast:    return easeCurve<ElasticEaseInFast>::calc<Ti,To>(easeMode,t,b,c,d);
+			case ElasticEaseOutFast:   return easeCurve<ElasticEaseOutFast>::calc<Ti,To>(easeMode,t,b,c,d);
+			case ElasticEaseInOutFast: return easeCurve<ElasticEaseInOutFast>::calc<Ti,To>(easeMode,t,b,c,d);
+		}
+	}
+};
+
+// Forward differencing for the polynomial curves. After start() at normalized
+// time x with step h, next() advances the normalized value one step with at
+// most five additions. Only the single-piece curves (linear and the In/Out
+// quad, cubic, quart and quint) qualify; degree is 0 for all others.
+struct easeForward {
+	float         diff[6];                                                  // value and forward differences
+	unsigned char degree;
+
+	static unsigned char degreeOf(easingType easeMode) {
+		switch (easeMode) {
+			case LinearEaseIn:  case LinearEaseOut:  case LinearEaseInOut: return 1;
+			case QuadEaseIn:    case QuadEaseOut:                          return 2;
+			case CubicEaseIn:   case CubicEaseOut:                         return 3;
+			case QuartEaseIn:   case QuartEaseOut:                         return 4;
+			case QuintEaseIn:   case QuintEaseOut:                         return 5;
+			default:                                                       return 0;
+		}
+	}
+
+	// Builds the difference table at x from the Taylor coefficients of the curve,
+	// a[j] = h^j p^(j)(x) / j!, as sampling and subtracting loses all precision for
+	// small h. Returns the value at x.
+	float start(easingType easeMode, float x, float h) {
+		static const unsigned char binomial[6][6] = { {1}, {1,1}, {1,2,1}, {1,3,3,1}, {1,4,6,4,1}, {1,5,10,10,5,1} };
+		static const unsigned char stirling[6][6] = {                   // k! S(j,k), Stirling numbers of the second kind
+			{1}, {0,1}, {0,1,2}, {0,1,6,6}, {0,1,14,36,24}, {0,1,30,150,240,120}
+		};
+		degree = degreeOf(easeMode);
+		bool  out  = easeMode == QuadEaseOut || easeMode == CubicEaseOut || easeMode == QuartEaseOut || easeMode == QuintEaseOut;
+		float y    = out ? x - 1 : x;                                      // Out curves are 1 - (1-x)^n
+		float sign = (out && (degree & 1) == 0) ? -1.0f : 1.0f;
+
+		float a[6], hj = 1;
+		for (unsigned char j = 0; j <= degree; j++) {
+			float yn = 1;
+			for (unsigned char k = j; k < degree; k++) yn *= y;
+			a[j] = sign * binomial[degree][j] * yn * hj;
+			hj  *= h;
+		}
+		if (out) a[0] += 1;
+
+		for (unsigned char k = 0; k <= degree; k++) {
+			diff[k] = 0;
+			for (unsigned char j = k; j <= degree; j++) diff[k] += stirling[j][k] * a[j];
+		}
+		return diff[0];
+	}
+
+	float next() {
+		for (unsigned char k = 0; k < degree; k++) diff[k] += diff[k + 1];
+		return diff[0];
+	}
+};
+
+// Whether Tween may step Curve forward with easeForward instead of evaluating
+// it. Curve policies that do not follow the polynomial for their mode
+// specialize this to false.
+template <class Curve> struct easeSteppable {
+	static const bool value = true;
+};
+
+// Whether Curve evaluates the easingType passed to it at run time. Every other
+// policy is fixed to its own curve, Curve::mode, and ignores the argument.
+template <class Curve> struct easeRuntimeMode {
+	static const bool value = false;
+};
+
+template <> struct easeRuntimeMode<easeRuntime> {
+	static const bool value = true;
+};
@@ -0,0 +1,109 @@
+/*
+  EaseBake.h - easing curves sampled at compile time
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include "easeconst.h"
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#define EASE_ROM PROGMEM
+#else
+#define EASE_ROM
+#endif
+
+// A curve sampled at Steps + 1 evenly spaced points between from and to.
+// Declaring it constexpr makes the compiler compute it; EASE_ROM keeps it in
+// flash on AVR. Read it with at(), which knows where to look:
+//
+//   static constexpr bakedCurve<unsigned char, 64> fade EASE_ROM = bakeCurve<SineEaseInOut, 64, unsigned char>(0, 255);
+//   Tween<unsigned long, unsigned char, easeBaked<decltype(fade), fade> > led;
+//   led.from(fade.first()).to(fade.last()).duringMsec(800).onUpdate(setLed).start();
+//
+// The tween plays the samples back without any easing math per frame; seek()
+// picks the nearest sample. from() and to() should match the baked ends, as
+// seek() returns them exactly at the start and the end of the tween.
+template <class Tout, unsigned int Steps> struct bakedCurve
+{
+	Tout value[Steps + 1];
+
+	static const unsigned int steps = Steps;
+
+	Tout at(unsigned int i) const {
+#if defined(__AVR__)
+		Tout result;
+		memcpy_P(&result, &value[i], sizeof(Tout));
+		return result;
+#else
+		return value[i];
+#endif
+	}
+
+	Tout first() const { return at(0);     }
+	Tout last() const  { return at(Steps); }
+};
+
+// Index packs to expand the samples, built by halving so that large tables stay
+// within the compiler's template depth
+template <unsigned int... I> struct easeIndices {};
+
+template <class A, class B> struct easeJoinIndices;
+template <unsigned int... I, unsigned int... J> struct easeJoinIndices<easeIndices<I...>, easeIndices<J...> > {
+	typedef easeIndices<I..., (sizeof...(I) + J)...> type;
+};
+
+template <unsigned int N> struct easeMakeIndices {
+	typedef typename easeJoinIndices<typename easeMakeIndices<N / 2>::type, typename easeMakeIndices<N - N / 2>::type>::type type;
+};
+template <> struct easeMakeIndices<0> { typedef easeIndices<>  type; };
+template <> struct easeMakeIndices<1> { typedef easeIndices<0> type; };
+
+template <easingType E, unsigned int Steps, class Tout, unsigned int... I>
+constexpr bakedCurve<Tout, Steps> bakeCurve(Tout from, Tout to, easeIndices<I...>) {
+	return bakedCurve<Tout, Steps>{ { easingConst::calc<double, Tout>(E, double(I), from, Tout(to - from), double(Steps))... } };
+}
+
+// Samples curve E from from to to at Steps + 1 points, at compile time
+template <easingType E, unsigned int Steps, class Tout>
+constexpr bakedCurve<Tout, Steps> bakeCurve(Tout from, Tout to) {
+	return bakeCurve<E, Steps, Tout>(from, to, typename easeMakeIndices<Steps + 1>::type());
+}
+
+// Curve policy that plays back a baked curve; easing() has no effect
+template <class Baked, const Baked& curve> struct easeBaked
+{
+	static const easingType mode = LinearEaseIn;
+
+	template <typename Ti, typename To> static To calc(easingType, Ti t, To, To, Ti d) {
+		if (!(t < d)) return curve.last();
+		return curve.at((unsigned int)(float(t) * curve.steps / float(d) + 0.5f));
+	}
+};
+
+// Played back samples do not follow the polynomial for mode, so Tween must not
+// step them forward
+template <class Baked, const Baked& curve> struct easeSteppable< easeBaked<Baked, curve> > {
+	static const bool value = false;
+};
@@ -0,0 +1,264 @@
+/*
+  easeBatch.h - easing functions evaluated over arrays of floats
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "ease.h"
+
+// Batch evaluation: out[i] = ease(t[i], b[i], c[i], d[i]) for i < n.
+//
+// Every curve is written on the normalized time x = t/d without data-dependent
+// branches: piecewise curves compute both sides and pick one with select(), a
+// bit mask rather than ?:, and pow(2,x), sin and sqrt are replaced by
+// polynomial / bit-level approximations. That leaves straight-line loops which
+// the compiler vectorizes for whatever the target offers (SSE2, AVX2 with
+// -mavx2, NEON), so there are no per-ISA intrinsic paths to maintain. gcc 12
+// vectorizes all 31 loops at plain -O3, or at -O2 -ftree-vectorize, for SSE2
+// and AVX2; with float ?: it would need -fno-trapping-math, as gcc does not
+// if-convert a float select that might trap. NEON builds were not measured.
+//
+// Accuracy, normalized curve against the scalar easing:: functions sampled
+// over x in [0,1]: absolute error below 5e-7 for every curve (exact for the
+// polynomial curves), so out[i] stays within 5e-7 * |c[i]| of the scalar
+// result, plus float rounding of b + c*f. Measured at -O2 by
+// extras/EaseBatchCheck; -ffast-math lets the compiler reassociate both sides
+// and adds up to about 1e-6.
+//
+// The *Fast elastic modes run the same curves as the accurate ones: the batch
+// approximations already cost about as much as the scalar sin16F/exp2F
+// shortcuts, so the batch *Fast values stay within 4e-4 of the scalar *Fast
+// curves, as those do of libm.
+//
+// On AVR there is no FPU and no vector unit, so the batch call simply loops
+// over the scalar easing:: kernels.
+class easeBatch
+{
+
+public:
+
+	static void evaluate(easingType easeMode, const float* t, const float* b, const float* c, const float* d, float* out, size_t n) {
+#if defined(__AVR__)
+		for (size_t i = 0; i < n; i++) out[i] = easeRuntime::calc<float,float>(easeMode, t[i], b[i], c[i], d[i]);
+#else
+		switch (easeMode) {
+			default:
+			case LinearEaseIn:
+			case LinearEaseOut:
+			case LinearEaseInOut:  run<linear>         (t,b,c,d,out,n); break;
+			case BackEaseIn:       run<backIn>         (t,b,c,d,out,n); break;
+			case BackEaseOut:      run<backOut>        (t,b,c,d,out,n); break;
+			case BackEaseInOut:    run<backInOut>      (t,b,c,d,out,n); break;
+			case BounceEaseIn:     run<bounceIn>       (t,b,c,d,out,n); break;
+			case BounceEaseOut:    run<bounceOut>      (t,b,c,d,out,n); break;
+			case BounceEaseInOut:  run<bounceInOut>    (t,b,c,d,out,n); break;
+			case CircEaseIn:       run<circIn>         (t,b,c,d,out,n); break;
+			case CircEaseOut:      run<circOut>        (t,b,c,d,out,n); break;
+			case CircEaseInOut:    run<circInOut>      (t,b,c,d,out,n); break;
+			case CubicEaseIn:      run<cubicIn>        (t,b,c,d,out,n); break;
+			case CubicEaseOut:     run<cubicOut>       (t,b,c,d,out,n); break;
+			case CubicEaseInOut:   run<cubicInOut>     (t,b,c,d,out,n); break;
+			case ElasticEaseInFast:
+			case ElasticEaseIn:    run<elasticIn>      (t,b,c,d,out,n); break;
+			case ElasticEaseOutFast:
+			case ElasticEaseOut:   run<elasticOut>     (t,b,c,d,out,n); break;
+			case ElasticEaseInOutFast:
+			case ElasticEaseInOut: run<elasticInOut>   (t,b,c,d,out,n); break;
+			case ExpoEaseIn:       run<expoIn>         (t,b,c,d,out,n); break;
+			case ExpoEaseOut:      run<expoOut>        (t,b,c,d,out,n); break;
+			case ExpoEaseInOut:    run<expoInOut>      (t,b,c,d,out,n); break;
+			case QuadEaseIn:       run<quadIn>         (t,b,c,d,out,n); break;
+			case QuadEaseOut:      run<quadOut>        (t,b,c,d,out,n); break;
+			case QuadEaseInOut:    run<quadInOut>      (t,b,c,d,out,n); break;
+			case QuartEaseIn:      run<quartIn>        (t,b,c,d,out,n); break;
+			case QuartEaseOut:     run<quartOut>       (t,b,c,d,out,n); break;
+			case QuartEaseInOut:   run<quartInOut>     (t,b,c,d,out,n); break;
+			case QuintEaseIn:      run<quintIn>        (t,b,c,d,out,n); break;
+			case QuintEaseOut:     run<quintOut>       (t,b,c,d,out,n); break;
+			case QuintEaseInOut:   run<quintInOut>     (t,b,c,d,out,n); break;
+			case SineEaseIn:       run<sineIn>         (t,b,c,d,out,n); break;
+			case SineEaseOut:      run<sineOut>        (t,b,c,d,out,n); break;
+			case SineEaseInOut:    run<sineInOut>      (t,b,c,d,out,n); break;
+		}
+#endif
+	}
+
+	/*-----------------------------
+	  APPROXIMATIONS
+	-----------------------------*/
+
+	// cond ? a : b, evaluated as a bit mask so it stays a vector blend
+	static inline float select(bool cond, float a, float b) {
+		int32_t ia, ib, mask = -int32_t(cond);
+		memcpy(&ia, &a, sizeof(ia));
+		memcpy(&ib, &b, sizeof(ib));
+		int32_t r = (ia & mask) | (ib & ~mask);
+		float y;
+		memcpy(&y, &r, sizeof(y));
+		return y;
+	}
+
+	// 2^x for -126 < x < 128: exponent from the integer part, 6th order polynomial
+	// for the fraction in [-0.5,0.5]. Relative error below 3e-7
+	static inline float exp2Approx(float x) {
+		x = select(x < -125.f, -125.f, x);
+		int   n = int(x + 128.5f) - 128;
+		float f = x - float(n);
+		float p = 1.f + f*(0.69314718f + f*(0.24022651f + f*(0.05550411f + f*(0.00961813f + f*(0.00133336f + f*0.00015404f)))));
+		int   e = (n + 127) << 23;
+		float s;
+		memcpy(&s, &e, sizeof(s));
+		return p * s;
+	}
+
+	// sin(x) for |x| < 200: reduced to [-pi,pi], reflected to [-pi/2,pi/2], then
+	// an 11th order odd polynomial. Absolute error below 2e-7 in the reduced range
+	static inline float sinApprox(float x) {
+		const float twoPi = 6.28318531f, halfPi = 1.57079633f, pi = 3.14159265f;
+		float k = float(int(x * (1.f / twoPi) + 64.5f) - 64);
+		float y = x - k * twoPi;
+		y = select(y >  halfPi,  pi - y, y);
+		y = select(y < -halfPi, -pi - y, y);
+		float y2 = y * y;
+		return y * (1.f + y2*(-1.6666667e-1f + y2*(8.3333333e-3f + y2*(-1.9841270e-4f + y2*(2.7557319e-6f + y2*-2.5052108e-8f)))));
+	}
+
+	// sqrt(x) for x >= 0 as x * rsqrt(x): bit-level estimate plus three Newton steps.
+	// rsqrt runs on x kept above 1e-30, as the estimate for 0 squares to infinity
+	// and -ffast-math may then multiply it by 0
+	static inline float sqrtApprox(float x) {
+		x = select(x > 0.f, x, 0.f);
+		float r = select(x > 1e-30f, x, 1e-30f);
+		int   i;
+		float y;
+		memcpy(&i, &r, sizeof(i));
+		i = 0x5f3759df - (i >> 1);
+		memcpy(&y, &i, sizeof(y));
+		float h = 0.5f * r;
+		y = y * (1.5f - h * y * y);
+		y = y * (1.5f - h * y * y);
+		y = y * (1.5f - h * y * y);
+		return x * y;
+	}
+
+private:
+
+	template <float (*Kernel)(float)> static void run(const float* t, const float* b, const float* c, const float* d, float* out, size_t n) {
+		for (size_t i = 0; i < n; i++) out[i] = b[i] + c[i] * Kernel(t[i] / d[i]);
+	}
+
+	/*-----------------------------
+	  NORMALIZED CURVES, x = t/d
+	-----------------------------*/
+
+	static inline float linear(float x)    { return x; }
+
+	static inline float backIn(float x)    { const float s = 1.70158f; return x*x*((s + 1)*x - s); }
+	static inline float backOut(float x)   { const float s = 1.70158f; float y = x - 1; return y*y*((s + 1)*y + s) + 1; }
+	static inline float backInOut(float x) {
+		const float s = 1.70158f * 1.525f;
+		float u = 2*x, v = u - 2;
+		float lo = .5f*(u*u*((s + 1)*u - s));
+		float hi = .5f*(v*v*((s + 1)*v + s) + 2);
+		return select(u < 1, lo, hi);
+	}
+
+	static inline float bounceOut(float x) {
+		bool  a = x < (1 / 2.75f), b = x < (2 / 2.75f), c = x < (2.5f / 2.75f);
+		float off = select(a, 0.f, select(b, 1.5f / 2.75f, select(c, 2.25f / 2.75f, 2.625f / 2.75f)));
+		float add = select(a, 0.f, select(b, .75f,         select(c, .9375f,        .984375f)));
+		float y   = x - off;
+		return 7.5625f*y*y + add;
+	}
+	static inline float bounceIn(float x)    { return 1 - bounceOut(1 - x); }
+	static inline float bounceInOut(float x) {
+		float lo = .5f*bounceIn(2*x);
+		float hi = .5f*bounceOut(2*x - 1) + .5f;
+		return select(x < .5f, lo, hi);
+	}
+
+	static inline float circIn(float x)    { return 1 - sqrtApprox(1 - x*x); }
+	static inline float circOut(float x)   { float y = x - 1; return sqrtApprox(1 - y*y); }
+	static inline float circInOut(float x) {
+		float u = 2*x, v = u - 2;
+		float w = select(u < 1, u, v);
+		float r = sqrtApprox(1 - w*w);
+		return select(u < 1, .5f*(1 - r), .5f*(r + 1));
+	}
+
+	static inline float cubicIn(float x)    { return x*x*x; }
+	static inline float cubicOut(float x)   { float y = x - 1; return y*y*y + 1; }
+	static inline float cubicInOut(float x) { float u = 2*x, v = u - 2; return select(u < 1, .5f*u*u*u, .5f*(v*v*v + 2)); }
+
+	// The period and phase of the elastic curves do not depend on d once t is normalized
+	static inline float elasticIn(float x) {
+		const float w = 6.28318531f / .3f;
+		float y = x - 1;
+		float r = -(exp2Approx(10*y) * sinApprox((y - .075f) * w));
+		return select(x == 0, 0.f, select(x == 1, 1.f, r));
+	}
+	static inline float elasticOut(float x) {
+		const float w = 6.28318531f / .3f;
+		float r = exp2Approx(-10*x) * sinApprox((x - .075f) * w) + 1;
+		return select(x == 0, 0.f, select(x == 1, 1.f, r));
+	}
+	static inline float elasticInOut(float x) {
+		const float w = 6.28318531f / .45f;
+		float u = 2*x, y = u - 1;
+		float e = exp2Approx(select(u < 1, 10*y, -10*y));
+		float s = sinApprox((y - .1125f) * w);
+		float r = select(u < 1, -.5f*(e*s), e*s*.5f + 1);
+		return select(x == 0, 0.f, select(u == 2, 1.f, r));
+	}
+
+	static inline float expoIn(float x)  { float r = exp2Approx(10*(x - 1)); return select(x == 0, 0.f, r); }
+	static inline float expoOut(float x) { float r = 1 - exp2Approx(-10*x);  return select(x == 1, 1.f, r); }
+	static inline float expoInOut(float x) {
+		float u = 2*x, y = u - 1;
+		float e = exp2Approx(select(u < 1, 10*y, -10*y));
+		float r = select(u < 1, .5f*e, .5f*(2 - e));
+		return select(x == 0, 0.f, select(x == 1, 1.f, r));
+	}
+
+	static inline float quadIn(float x)    { return x*x; }
+	static inline float quadOut(float x)   { return -x*(x - 2); }
+	static inline float quadInOut(float x) { float u = 2*x, v = u - 1; return select(u < 1, .5f*u*u, -.5f*(v*(v - 2) - 1)); }
+
+	static inline float quartIn(float x)    { return x*x*x*x; }
+	static inline float quartOut(float x)   { float y = x - 1; return -(y*y*y*y - 1); }
+	static inline float quartInOut(float x) { float u = 2*x, v = u - 2; return select(u < 1, .5f*u*u*u*u, -.5f*(v*v*v*v - 2)); }
+
+	static inline float quintIn(float x)    { return x*x*x*x*x; }
+	static inline float quintOut(float x)   { float y = x - 1; return y*y*y*y*y + 1; }
+	static inline float quintInOut(float x) { float u = 2*x, v = u - 2; return select(u < 1, .5f*u*u*u*u*u, .5f*(v*v*v*v*v + 2)); }
+
+	// cos(a) is evaluated as sin(pi/2 - a)
+	static inline float sineIn(float x)    { return 1 - sinApprox(1.57079633f*(1 - x)); }
+	static inline float sineOut(float x)   { return sinApprox(1.57079633f*x); }
+	static inline float sineInOut(float x) { return -.5f*(sinApprox(1.57079633f - 3.14159265f*x) - 1); }
+
+};
@@ -0,0 +1,152 @@
+/*
+  EaseBezier.h - cubic Bezier and user-defined easing curves
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <math.h>
+#include "ease.h"
+
+// CSS style cubic-bezier(x1, y1, x2, y2) timing curve: a cubic Bezier from
+// (0,0) to (1,1) with control points (x1,y1) and (x2,y2), 0 <= x1, x2 <= 1.
+//
+// Evaluating it at x means finding the curve parameter t with X(t) = x first.
+// The constructor samples X at 17 evenly spaced t, which gives a starting
+// point within one interval of the answer; a few Newton-Raphson steps refine it.
+// The last solution is cached, so the next frame of a running tween starts
+// Newton next to its answer and typically converges in one or two steps.
+// Curves where Newton stalls (flat X) fall back to bisection.
+class cubicBezier
+{
+
+public:
+	static const unsigned char samples = 16;
+
+	cubicBezier(float x1, float y1, float x2, float y2) {
+		cx = 3 * x1;  bx = 3 * (x2 - x1) - cx;  ax = 1 - cx - bx;
+		cy = 3 * y1;  by = 3 * (y2 - y1) - cy;  ay = 1 - cy - by;
+		for (unsigned char i = 0; i <= samples; i++) table[i] = sampleX(float(i) / samples);
+		lastX = 0;
+		lastT = 0;
+	}
+
+	// Normalized value at normalized time x
+	float operator()(float x) const {
+		if (x <= 0) return 0;
+		if (x >= 1) return 1;
+		return sampleY(solve(x));
+	}
+
+	// Curve parameter t at which X(t) = x, within 1e-6
+	float solve(float x) const {
+		float t;
+		if (fabs(x - lastX) < 1.0f / samples) {
+			t = lastT;
+		} else {
+			unsigned char i = 0;
+			while (i < samples - 1 && table[i + 1] <= x) i++;
+			float span = table[i + 1] - table[i];
+			t = (i + (span > 0 ? (x - table[i]) / span : 0)) / samples;
+		}
+
+		for (unsigned char k = 0; k < 4; k++) {
+			float error = sampleX(t) - x;
+			if (fabs(error) < 1e-6f) return remember(x, t);
+			float slope = slopeX(t);
+			if (fabs(slope) < 1e-6f) break;
+			t -= error / slope;
+		}
+		if (t >= 0 && t <= 1 && fabs(sampleX(t) - x) < 1e-6f) return remember(x, t);
+
+		float lo = 0, hi = 1;                                                    // X is monotonic on 0..1
+		for (unsigned char k = 0; k < 24; k++) {
+			t = (lo + hi) / 2;
+			if (sampleX(t) < x) lo = t; else hi = t;
+		}
+		return remember(x, t);
+	}
+
+private:
+	float ax, bx, cx, ay, by, cy;                                              // polynomial coefficients of X(t) and Y(t)
+	float table[samples + 1];                                                  // X at t = i / samples
+	mutable float lastX, lastT;                                                // last solution
+
+	float sampleX(float t) const { return ((ax * t + bx) * t + cx) * t; }
+	float sampleY(float t) const { return ((ay * t + by) * t + cy) * t; }
+	float slopeX(float t) const  { return (3 * ax * t + 2 * bx) * t + cx; }
+
+	float remember(float x, float t) const {
+		lastX = x;
+		lastT = t;
+		return t;
+	}
+};
+
+// Curve policy for a cubic Bezier fixed at compile time, with the control
+// points in thousandths, e.g. the CSS ease curve cubic-bezier(.25, .1, .25, 1):
+//
+//   Tween<unsigned long, float, easeBezier<250, 100, 250, 1000> > tween;
+//
+// All tweens with the same control points share one curve and its cache.
+template <int X1, int Y1, int X2, int Y2> struct easeBezier
+{
+	static_assert(X1 >= 0 && X1 <= 1000 && X2 >= 0 && X2 <= 1000, "Bezier x coordinates must lie within 0..1000");
+
+	static const easingType mode = LinearEaseIn;
+
+	static const cubicBezier& curve() {
+		static const cubicBezier bezier(X1 / 1000.0f, Y1 / 1000.0f, X2 / 1000.0f, Y2 / 1000.0f);
+		return bezier;
+	}
+
+	template <typename Ti, typename To> static To calc(easingType, Ti t, To b, To c, Ti d) {
+		return c * curve()(float(t) / float(d)) + b;
+	}
+};
+
+// Curve policy for a user-defined easing function that maps normalized time
+// (0..1) to the normalized value, e.g.
+//
+//   float smoothstep(float x) { return x * x * (3 - 2 * x); }
+//   Tween<unsigned long, float, easeFunction<smoothstep> > tween;
+//
+// A curve known only at run time, such as a cubicBezier read from a file, can
+// be wrapped in a function that evaluates it.
+template <float (*Function)(float)> struct easeFunction
+{
+	static const easingType mode = LinearEaseIn;
+
+	template <typename Ti, typename To> static To calc(easingType, Ti t, To b, To c, Ti d) {
+		return c * Function(float(t) / float(d)) + b;
+	}
+};
+
+// Neither follows the polynomial for its mode, so Tween must not step them forward
+template <int X1, int Y1, int X2, int Y2> struct easeSteppable< easeBezier<X1, Y1, X2, Y2> > {
+	static const bool value = false;
+};
+
+template <float (*Function)(float)> struct easeSteppable< easeFunction<Function> > {
+	static const bool value = false;
+};
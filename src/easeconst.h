@@ -0,0 +1,250 @@
+/*
+  EaseConst.h - constexpr easing curves
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include "ease.h"
+
+// constexpr versions of the easing curves, for values that are known at
+// compile time (see easebake.h). They follow the float curves in ease.h, but
+// replace pow, sin, cos and sqrt by constexpr series, so they stay within 1e-6
+// of the libm based results.
+//
+// The curves work on normalized time x (0..1) and return the normalized value.
+// Bodies are single expressions, as C++11 constexpr requires. At run time they
+// are slower than the functions in easing, so use them for constants only.
+//
+//   constexpr float half = easingConst::value(CubicEaseInOut, 0.5);            // 0.5
+//   constexpr int   led  = easingConst::calc<int,int>(QuadEaseIn, 30, 0, 255, 100);
+class easingConst
+{
+
+public:
+	static constexpr double pi = 3.14159265358979323846;
+
+	/*-----------------------------
+	  CONSTEXPR MATH
+	-----------------------------*/
+
+	static constexpr double floor(double x) {
+		return double((long)x) > x ? double((long)x) - 1 : double((long)x);
+	}
+
+	static constexpr double pow2(int n) {
+		return n == 0 ? 1 : n < 0 ? 0.5 * pow2(n + 1) : 2 * pow2(n - 1);
+	}
+
+	// 2^f for 0 <= f < 1 as the Taylor series of e^(f ln 2), Horner form
+	static constexpr double exp2Fraction(double y) {
+		return 1 + y * (1 + y / 2 * (1 + y / 3 * (1 + y / 4 * (1 + y / 5 * (1 + y / 6 * (1 + y / 7 * (1 + y / 8 * (1 + y / 9 * (1 + y / 10)))))))));
+	}
+
+	static constexpr double exp2(double x) {
+		return pow2(int(floor(x))) * exp2Fraction((x - floor(x)) * 0.69314718055994530942);
+	}
+
+	// sin(r) for -pi/2 <= r <= pi/2, Taylor series up to r^13
+	static constexpr double sinHalfPi(double r) {
+		return r * (1 - r*r / 6 * (1 - r*r / 20 * (1 - r*r / 42 * (1 - r*r / 72 * (1 - r*r / 110 * (1 - r*r / 156))))));
+	}
+
+	// sin(r) for -pi <= r <= pi, folded onto -pi/2..pi/2
+	static constexpr double sinPi(double r) {
+		return r > pi / 2 ? sinHalfPi(pi - r) : r < -pi / 2 ? sinHalfPi(-pi - r) : sinHalfPi(r);
+	}
+
+	static constexpr double sin(double x) {
+		return sinPi(x - 2 * pi * floor(x / (2 * pi) + 0.5));
+	}
+
+	static constexpr double cos(double x) {
+		return sin(x + pi / 2);
+	}
+
+	static constexpr double sqrtNewton(double x, double guess, int iterations) {
+		return iterations == 0 ? guess : sqrtNewton(x, (guess + x / guess) / 2, iterations - 1);
+	}
+
+	// Newton iteration from 1; 32 steps converge for all x the curves produce (0..1)
+	static constexpr double sqrt(double x) {
+		return x <= 0 ? 0 : sqrtNewton(x, 1, 32);
+	}
+
+	/*-----------------------------
+	  NORMALIZED CURVES
+	-----------------------------*/
+
+	static constexpr double linearEaseIn   (double x) { return x; }
+	static constexpr double linearEaseOut  (double x) { return x; }
+	static constexpr double linearEaseInOut(double x) { return x; }
+
+	static constexpr double backEaseIn(double x) {
+		return x * x * ((1.70158 + 1) * x - 1.70158);
+	}
+	static constexpr double backEaseOut(double x) {
+		return (x - 1) * (x - 1) * ((1.70158 + 1) * (x - 1) + 1.70158) + 1;
+	}
+	static constexpr double backEaseInOut(double x) {
+		return x < 0.5 ? 0.5 * (2*x) * (2*x) * ((1.70158 * 1.525 + 1) * (2*x) - 1.70158 * 1.525)
+		               : 0.5 * ((2*x - 2) * (2*x - 2) * ((1.70158 * 1.525 + 1) * (2*x - 2) + 1.70158 * 1.525) + 2);
+	}
+
+	static constexpr double bounceEaseOut(double x) {
+		return x < 1 / 2.75   ? 7.5625 * x * x
+		     : x < 2 / 2.75   ? 7.5625 * (x - 1.5   / 2.75) * (x - 1.5   / 2.75) + .75
+		     : x < 2.5 / 2.75 ? 7.5625 * (x - 2.25  / 2.75) * (x - 2.25  / 2.75) + .9375
+		     :                  7.5625 * (x - 2.625 / 2.75) * (x - 2.625 / 2.75) + .984375;
+	}
+	static constexpr double bounceEaseIn(double x) {
+		return 1 - bounceEaseOut(1 - x);
+	}
+	static constexpr double bounceEaseInOut(double x) {
+		return x < 0.5 ? bounceEaseIn(2*x) * .5 : bounceEaseOut(2*x - 1) * .5 + .5;
+	}
+
+	static constexpr double circEaseIn(double x) {
+		return 1 - sqrt(1 - x * x);
+	}
+	static constexpr double circEaseOut(double x) {
+		return sqrt(1 - (x - 1) * (x - 1));
+	}
+	static constexpr double circEaseInOut(double x) {
+		return x < 0.5 ? -0.5 * (sqrt(1 - 4*x*x) - 1) : 0.5 * (sqrt(1 - (2*x - 2) * (2*x - 2)) + 1);
+	}
+
+	static constexpr double cubicEaseIn(double x) {
+		return x * x * x;
+	}
+	static constexpr double cubicEaseOut(double x) {
+		return (x - 1) * (x - 1) * (x - 1) + 1;
+	}
+	static constexpr double cubicEaseInOut(double x) {
+		return x < 0.5 ? 4 * x*x*x : 0.5 * ((2*x - 2) * (2*x - 2) * (2*x - 2) + 2);
+	}
+
+	// Period 0.3 (0.45 for InOut) and phase shift period / 4, as in easing
+	static constexpr double elasticEaseIn(double x) {
+		return x <= 0 ? 0 : x >= 1 ? 1 : -(exp2(10 * (x - 1)) * sin((x - 1 - .075) * 2 * pi / .3));
+	}
+	static constexpr double elasticEaseOut(double x) {
+		return x <= 0 ? 0 : x >= 1 ? 1 : exp2(-10 * x) * sin((x - .075) * 2 * pi / .3) + 1;
+	}
+	static constexpr double elasticEaseInOut(double x) {
+		return x <= 0 ? 0 : x >= 1 ? 1
+		     : x < 0.5 ? -.5 * (exp2(10 * (2*x - 1)) * sin((2*x - 1 - .1125) * 2 * pi / .45))
+		     :           exp2(-10 * (2*x - 1)) * sin((2*x - 1 - .1125) * 2 * pi / .45) * .5 + 1;
+	}
+
+	static constexpr double expoEaseIn(double x) {
+		return x <= 0 ? 0 : exp2(10 * (x - 1));
+	}
+	static constexpr double expoEaseOut(double x) {
+		return x >= 1 ? 1 : 1 - exp2(-10 * x);
+	}
+	static constexpr double expoEaseInOut(double x) {
+		return x <= 0 ? 0 : x >= 1 ? 1 : x < 0.5 ? 0.5 * exp2(10 * (2*x - 1)) : 0.5 * (2 - exp2(-10 * (2*x - 1)));
+	}
+
+	static constexpr double quadEaseIn(double x) {
+		return x * x;
+	}
+	static constexpr double quadEaseOut(double x) {
+		return -x * (x - 2);
+	}
+	static constexpr double quadEaseInOut(double x) {
+		return x < 0.5 ? 2 * x*x : -0.5 * ((2*x - 1) * (2*x - 3) - 1);
+	}
+
+	static constexpr double quartEaseIn(double x) {
+		return x * x * x * x;
+	}
+	static constexpr double quartEaseOut(double x) {
+		return 1 - (x - 1) * (x - 1) * (x - 1) * (x - 1);
+	}
+	static constexpr double quartEaseInOut(double x) {
+		return x < 0.5 ? 8 * x*x*x*x : -0.5 * ((2*x - 2) * (2*x - 2) * (2*x - 2) * (2*x - 2) - 2);
+	}
+
+	static constexpr double quintEaseIn(double x) {
+		return x * x * x * x * x;
+	}
+	static constexpr double quintEaseOut(double x) {
+		return (x - 1) * (x - 1) * (x - 1) * (x - 1) * (x - 1) + 1;
+	}
+	static constexpr double quintEaseInOut(double x) {
+		return x < 0.5 ? 16 * x*x*x*x*x : 0.5 * ((2*x - 2) * (2*x - 2) * (2*x - 2) * (2*x - 2) * (2*x - 2) + 2);
+	}
+
+	static constexpr double sineEaseIn(double x) {
+		return 1 - cos(x * pi / 2);
+	}
+	static constexpr double sineEaseOut(double x) {
+		return sin(x * pi / 2);
+	}
+	static constexpr double sineEaseInOut(double x) {
+		return -0.5 * (cos(pi * x) - 1);
+	}
+
+	/*-----------------------------
+	  SELECTION
+	-----------------------------*/
+
+	// Normalized value of curve easeMode at x; the Fast elastic variants
+	// evaluate the exact elastic curve
+	static constexpr double value(easingType easeMode, double x) {
+		#define EaseConstCurves(EASEMETHOD, METHOD) \
+			easeMode == EASEMETHOD ## EaseIn    ? METHOD ## EaseIn(x)    : \
+			easeMode == EASEMETHOD ## EaseOut   ? METHOD ## EaseOut(x)   : \
+			easeMode == EASEMETHOD ## EaseInOut ? METHOD ## EaseInOut(x) :
+		return
+			EaseConstCurves(Linear,  linear)
+			EaseConstCurves(Back,    back)
+			EaseConstCurves(Bounce,  bounce)
+			EaseConstCurves(Circ,    circ)
+			EaseConstCurves(Cubic,   cubic)
+			EaseConstCurves(Elastic, elastic)
+			EaseConstCurves(Expo,    expo)
+			EaseConstCurves(Quad,    quad)
+			EaseConstCurves(Quart,   quart)
+			EaseConstCurves(Quint,   quint)
+			EaseConstCurves(Sine,    sine)
+			easeMode == ElasticEaseInFast    ? elasticEaseIn(x)    :
+			easeMode == ElasticEaseOutFast   ? elasticEaseOut(x)   :
+			easeMode == ElasticEaseInOutFast ? elasticEaseInOut(x) :
+			x;
+		#undef EaseConstCurves
+	}
+
+	// b + c * curve(t / d), rounded to the nearest value for integer outputs
+	template <typename Ti, typename To> static constexpr To calc(easingType easeMode, Ti t, To b, To c, Ti d) {
+		return round<To>(double(b) + double(c) * value(easeMode, d == 0 ? 1 : double(t) / double(d)));
+	}
+
+	// Integer types are recognised by truncating 0.5 to 0
+	template <typename To> static constexpr To round(double v) {
+		return To(0.5) == To(0) ? To(v < 0 ? v - 0.5 : v + 0.5) : To(v);
+	}
+
+};
@@ -0,0 +1,200 @@
+/*
+  easeFixed.h - fixed point easing functions for integer tweens
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <stdint.h>
+
+// Integer-only versions of the easing curves, used automatically when both the
+// input and the (8 or 16 bit) output type of a tween are integral, so 8-bit
+// targets skip the float emulation.
+//
+// Curves work on normalized time x in Q14 (16384 == 1.0) and return the
+// normalized value in Q14; apply() maps t, b, c, d onto that. Measured against
+// the float kernels, the normalized curves stay within 1.5e-3 (elastic, the
+// worst case; below 8e-4 for the others), so 8 bit outputs are within 1 of the
+// float result and 16 bit outputs within 1.5e-3 of the range.
+// extras/FixedPointCheck checks these bounds; the fixed/ and float/ groups of
+// examples/Benchmark time both kernels on the board.
+class easingFixed
+{
+
+public:
+	static const int32_t ONE = 16384;
+
+	// b + c * curve(t / d) with integer arithmetic only
+	template <typename Ti, typename To> static To apply(int32_t (*curve)(int32_t), Ti t, To b, To c, Ti d) {
+		if (d == 0 || t >= d) return To(b + c);
+		while (sizeof(Ti) > 2 && d > Ti(0x7FFF)) { t >>= 1; d >>= 1; }     // keep t << 14 within 32 bits; 8 and 16 bit Ti always fit
+		int32_t y = curve(int32_t((int32_t(t) << 14) / int32_t(d)));
+		int32_t cs = int32_t(c);
+		if (sizeof(To) == 1) return To(b + ((cs * y + (ONE >> 1)) >> 14));
+		return To(b + ((cs * (y >> 2) + ((cs * (y & 3) + 2) >> 2) + (ONE >> 3)) >> 12));   // 16 bit c: split y to stay within 32 bits
+	}
+
+	/*-----------------------------
+	  HELPERS
+	-----------------------------*/
+
+	static int32_t mul(int32_t a, int32_t b) {
+		return (a * b + (ONE >> 1)) >> 14;
+	}
+
+	// Square root of a Q14 value in [0,1]
+	static int32_t sqrt(int32_t v) {
+		if (v <= 0) return 0;
+		uint32_t op = uint32_t(v) << 14, res = 0, one = uint32_t(1) << 30;
+		while (one > op) one >>= 2;
+		while (one != 0) {
+			if (op >= res + one) { op -= res + one; res += one << 1; }
+			res >>= 1;
+			one >>= 2;
+		}
+		return int32_t(res);
+	}
+
+	// 2^e for a Q14 exponent e <= 0: shift for the integer part, cubic for the fraction
+	static int32_t exp2(int32_t e) {
+		int32_t n = e >> 14;                                                  // floor
+		int32_t f = e - (n << 14);
+		int32_t p = ONE + mul(f, 11400 + mul(f, 3688 + mul(f, 1297)));        // 0.6958, 0.2251, 0.0792
+		return n <= -15 ? 0 : p >> -n;
+	}
+
+	// Sine in Q14 of a 16 bit phase (65536 == one turn), quarter wave polynomial
+	static int32_t sin(uint16_t phase) {
+		int32_t z = int32_t(phase & 0x3FFF);
+		if (phase & 0x4000) z = ONE - z;
+		int32_t z2 = mul(z, z);
+		int32_t y  = mul(z, 25736 - mul(z2, 10512 - mul(z2, 1160)));         // pi/2, pi - 5/2, pi/2 - 3/2
+		return (phase & 0x8000) ? -y : y;
+	}
+
+	/*-----------------------------
+	  EASING FUNCTIONS, x in Q14
+	-----------------------------*/
+
+	static int32_t linearEaseIn(int32_t x)    { return x; }
+	static int32_t linearEaseOut(int32_t x)   { return x; }
+	static int32_t linearEaseInOut(int32_t x) { return x; }
+
+	static int32_t backEaseIn(int32_t x)  { return mul(mul(x, x), mul(44263, x) - 27879); }                        // s = 1.70158
+	static int32_t backEaseOut(int32_t x) { int32_t y = x - ONE; return mul(mul(y, y), mul(44263, y) + 27879) + ONE; }
+	static int32_t backEaseInOut(int32_t x) {
+		int32_t u = 2 * x;                                                                                              // s = 1.70158 * 1.525
+		if (u < ONE) return mul(mul(u, u), mul(58899, u) - 42515) / 2;
+		int32_t v = u - 2 * ONE;
+		return (mul(mul(v, v), mul(58899, v) + 42515) + 2 * ONE) / 2;
+	}
+
+	static int32_t bounceEaseOut(int32_t x) {
+		if (x < 5958)  {                 return mul(mul(123904, x), x);                }       // 1/2.75, 7.5625
+		if (x < 11916) { x -= 8937;      return mul(mul(123904, x), x) + 12288;        }       // 2/2.75, 1.5/2.75, .75
+		if (x < 14895) { x -= 13405;     return mul(mul(123904, x), x) + 15360;        }       // 2.5/2.75, 2.25/2.75, .9375
+		                 x -= 15639;     return mul(mul(123904, x), x) + 16128;                // 2.625/2.75, .984375
+	}
+	static int32_t bounceEaseIn(int32_t x)    { return ONE - bounceEaseOut(ONE - x); }
+	static int32_t bounceEaseInOut(int32_t x) {
+		if (x < ONE / 2) return bounceEaseIn(2 * x) / 2;
+		return bounceEaseOut(2 * x - ONE) / 2 + ONE / 2;
+	}
+
+	static int32_t circEaseIn(int32_t x)  { return ONE - sqrt(ONE - mul(x, x)); }
+	static int32_t circEaseOut(int32_t x) { int32_t y = x - ONE; return sqrt(ONE - mul(y, y)); }
+	static int32_t circEaseInOut(int32_t x) {
+		int32_t u = 2 * x;
+		if (u < ONE) return (ONE - sqrt(ONE - mul(u, u))) / 2;
+		int32_t v = u - 2 * ONE;
+		return (sqrt(ONE - mul(v, v)) + ONE) / 2;
+	}
+
+	static int32_t cubicEaseIn(int32_t x)  { return mul(mul(x, x), x); }
+	static int32_t cubicEaseOut(int32_t x) { int32_t y = x - ONE; return mul(mul(y, y), y) + ONE; }
+	static int32_t cubicEaseInOut(int32_t x) {
+		if (x < ONE / 2) return 4 * mul(mul(x, x), x);
+		int32_t v = 2 * x - 2 * ONE;
+		return (mul(mul(v, v), v) + 2 * ONE) / 2;
+	}
+
+	// Phases are in 1/65536 turns: a period of .3 (.45 for InOut) and an offset of p/4
+	static int32_t elasticEaseIn(int32_t x) {
+		if (x <= 0 || x >= ONE) return x <= 0 ? 0 : ONE;
+		int32_t y = x - ONE;
+		return -mul(exp2(10 * y), sin(uint16_t((y - 1229) * 40 / 3)));
+	}
+	static int32_t elasticEaseOut(int32_t x) {
+		if (x <= 0 || x >= ONE) return x <= 0 ? 0 : ONE;
+		return mul(exp2(-10 * x), sin(uint16_t((x - 1229) * 40 / 3))) + ONE;
+	}
+	static int32_t elasticEaseInOut(int32_t x) {
+		if (x <= 0 || x >= ONE) return x <= 0 ? 0 : ONE;
+		int32_t  y = 2 * x - ONE;
+		int32_t  s = sin(uint16_t((y - 1843) * 80 / 9));
+		if (y < 0) return -mul(exp2(10 * y), s) / 2;
+		return mul(exp2(-10 * y), s) / 2 + ONE;
+	}
+	static int32_t elasticEaseInFast(int32_t x)    { return elasticEaseIn(x);    }
+	static int32_t elasticEaseOutFast(int32_t x)   { return elasticEaseOut(x);   }
+	static int32_t elasticEaseInOutFast(int32_t x) { return elasticEaseInOut(x); }
+
+	static int32_t expoEaseIn(int32_t x)  { return x <= 0   ? 0   : exp2(10 * (x - ONE)); }
+	static int32_t expoEaseOut(int32_t x) { return x >= ONE ? ONE : ONE - exp2(-10 * x);  }
+	static int32_t expoEaseInOut(int32_t x) {
+		if (x <= 0 || x >= ONE) return x <= 0 ? 0 : ONE;
+		int32_t y = 2 * x - ONE;
+		if (y < 0) return exp2(10 * y) / 2;
+		return (2 * ONE - exp2(-10 * y)) / 2;
+	}
+
+	static int32_t quadEaseIn(int32_t x)  { return mul(x, x); }
+	static int32_t quadEaseOut(int32_t x) { return mul(x, 2 * ONE - x); }
+	static int32_t quadEaseInOut(int32_t x) {
+		if (x < ONE / 2) return 2 * mul(x, x);
+		int32_t v = 2 * x - ONE;
+		return (ONE - mul(v, v - 2 * ONE)) / 2;
+	}
+
+	static int32_t quartEaseIn(int32_t x)  { int32_t x2 = mul(x, x); return mul(x2, x2); }
+	static int32_t quartEaseOut(int32_t x) { int32_t y2 = mul(x - ONE, x - ONE); return ONE - mul(y2, y2); }
+	static int32_t quartEaseInOut(int32_t x) {
+		if (x < ONE / 2) { int32_t x2 = mul(x, x); return 8 * mul(x2, x2); }
+		int32_t v = 2 * x - 2 * ONE, v2 = mul(v, v);
+		return (2 * ONE - mul(v2, v2)) / 2;
+	}
+
+	static int32_t quintEaseIn(int32_t x)  { int32_t x2 = mul(x, x); return mul(mul(x2, x2), x); }
+	static int32_t quintEaseOut(int32_t x) { int32_t y = x - ONE, y2 = mul(y, y); return mul(mul(y2, y2), y) + ONE; }
+	static int32_t quintEaseInOut(int32_t x) {
+		if (x < ONE / 2) { int32_t x2 = mul(x, x); return 16 * mul(mul(x2, x2), x); }
+		int32_t v = 2 * x - 2 * ONE, v2 = mul(v, v);
+		return (mul(mul(v2, v2), v) + 2 * ONE) / 2;
+	}
+
+	// A quarter turn is 16384 phase steps, so x maps onto the phase directly
+	static int32_t sineEaseIn(int32_t x)    { return ONE - sin(uint16_t(x + 16384)); }
+	static int32_t sineEaseOut(int32_t x)   { return sin(uint16_t(x)); }
+	static int32_t sineEaseInOut(int32_t x) { return (ONE - sin(uint16_t(2 * x + 16384))) / 2; }
+
+};
@@ -0,0 +1,87 @@
+/*
+  easeLut.h - table based easing functions
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include "easebake.h"
+
+// Table based curve policy: easeLut<E, N> samples the normalized curve E at
+// N+1 points at compile time, into a table shared by all tweens using the same
+// E and N, and evaluates by lookup plus linear interpolation. This avoids the
+// pow/sin/cos/sqrt calls of the elastic, expo, sine and circ easings on every
+// frame, which matters most on targets without an FPU.
+//
+//   Tween<unsigned long, float, easeLut<ElasticEaseOut, 256> > tween;
+//
+// The table is stored as 16 bit values with 14 fractional bits (range -2..2,
+// enough for the back and elastic overshoot). It is baked with easingConst and
+// kept in flash with EASE_ROM on AVR (see easebake.h), so its 2*(N+1) bytes
+// take no RAM and there is no first-use initialisation to race on.
+// maxError() reports the measured interpolation error of a given table, e.g. for
+// N = 256: sine 4e-5, elastic 7e-4, expo 9e-4 (the jump at t = 0), bounce 3e-3
+// and circ 2e-2 (the vertical tangent at the end of the curve).
+template <easingType E, unsigned int N = 256> struct easeLut
+{
+	static const easingType mode = E;
+
+	template <typename Ti, typename To> static To calc(easingType, Ti t, To b, To c, Ti d) {
+		return c * sample(float(t) / float(d)) + b;
+	}
+
+	// Normalized curve value at x, 0 <= x <= 1
+	static float sample(float x) {
+		if (x <= 0) return lut.first() * (1.0f / scale);
+		if (x >= 1) return lut.last() * (1.0f / scale);
+		float        f = x * N;
+		unsigned int i = (unsigned int)(f);
+		f -= i;
+		short lo = lut.at(i), hi = lut.at(i + 1);
+		return (lo + f * (hi - lo)) * (1.0f / scale);
+	}
+
+	// Largest absolute difference between sample() and the exact normalized curve,
+	// probed at 8 points between every pair of table entries
+	static float maxError() {
+		float worst = 0;
+		for (unsigned long k = 0; k <= 8ul * N; k++) {
+			float x   = float(k) / (8.0f * N);
+			float err = sample(x) - exact(x);
+			if (err < 0)     err = -err;
+			if (err > worst) worst = err;
+		}
+		return worst;
+	}
+
+private:
+	static const int scale = 1 << 14;
+
+	static float exact(float x) {
+		return easeCurve<E>::template calc<float,float>(E, x, 0.0f, 1.0f, 1.0f);
+	}
+
+	static constexpr bakedCurve<short, N> lut EASE_ROM = bakeCurve<E, N, short>(0, short(scale));
+};
+
+template <easingType E, unsigned int N> constexpr bakedCurve<short, N> easeLut<E, N>::lut;
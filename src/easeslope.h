@@ -0,0 +1,183 @@
+/*
+  EaseSlope.h - derivatives of the easing curves
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <math.h>
+#include "ease.h"
+
+// Slope f'(x) of the normalized easing curves f on [0,1], from the analytic
+// derivative of each curve in ease.h. The Out and InOut variants follow from
+// the In curve by symmetry where ease.h builds them that way; back and elastic
+// InOut use their own constants and are derived separately. Circ is vertical
+// at its ends, where the slope is capped.
+class easingSlope
+{
+	static constexpr float ln2x10     = 6.9314718f;                          // d/dx 2^(10x) = 10 ln 2 * 2^(10x)
+	static constexpr float maxSlope   = 1000.0f;
+	static constexpr float back       = 1.70158f;
+	static constexpr float backInOut  = 1.70158f * 1.525f;
+
+	static float power(float x, unsigned char n) {
+		float p = 1;
+		while (n-- > 0) p *= x;
+		return p;
+	}
+
+	// x^n scaled by n 2^(n-1) in the first half of InOut, which is n x^(n-1) for In
+	static float polyIn(float x, unsigned char n)    { return n * power(x, n - 1); }
+	static float polyInOut(float x, unsigned char n) { return n * power(2, n - 1) * power(x < .5f ? x : 1 - x, n - 1); }
+
+	static float circIn(float x) {
+		float r = 1 - x * x;
+		return r * maxSlope * maxSlope <= x * x ? maxSlope : x / sqrt(r);
+	}
+
+	static float backIn(float x, float s)  { return 3 * (s + 1) * x * x - 2 * s * x; }
+
+	static float bounceOut(float x) {
+		if (x < 1 / 2.75f)   return 2 * 7.5625f * x;
+		if (x < 2 / 2.75f)   return 2 * 7.5625f * (x - 1.5f / 2.75f);
+		if (x < 2.5f / 2.75f) return 2 * 7.5625f * (x - 2.25f / 2.75f);
+		return 2 * 7.5625f * (x - 2.625f / 2.75f);
+	}
+
+	// -(2^(10u) sin(w(u - p/4))) with u = x - 1, for period p
+	static float elasticIn(float u, float p) {
+		float w = float(TWO_PI) / p, e = pow(2, 10 * u);
+		return -e * (ln2x10 * sin(w * (u - p / 4)) + w * cos(w * (u - p / 4)));
+	}
+
+	// 2^(-10x) sin(w(x - p/4)) + 1, for period p
+	static float elasticOut(float x, float p) {
+		float w = float(TWO_PI) / p, e = pow(2, -10 * x);
+		return e * (w * cos(w * (x - p / 4)) - ln2x10 * sin(w * (x - p / 4)));
+	}
+
+public:
+
+	static float slope(easingType mode, float x) {
+		if (x < 0) x = 0;
+		if (x > 1) x = 1;
+		switch (mode) {
+			case LinearEaseIn:
+			case LinearEaseOut:
+			case LinearEaseInOut:      return 1;
+			case QuadEaseIn:           return polyIn(x, 2);
+			case QuadEaseOut:          return polyIn(1 - x, 2);
+			case QuadEaseInOut:        return polyInOut(x, 2);
+			case CubicEaseIn:          return polyIn(x, 3);
+			case CubicEaseOut:         return polyIn(1 - x, 3);
+			case CubicEaseInOut:       return polyInOut(x, 3);
+			case QuartEaseIn:          return polyIn(x, 4);
+			case QuartEaseOut:         return polyIn(1 - x, 4);
+			case QuartEaseInOut:       return polyInOut(x, 4);
+			case QuintEaseIn:          return polyIn(x, 5);
+			case QuintEaseOut:         return polyIn(1 - x, 5);
+			case QuintEaseInOut:       return polyInOut(x, 5);
+			case SineEaseIn:           return float(PI / 2) * sin(x * float(PI / 2));
+			case SineEaseOut:          return float(PI / 2) * cos(x * float(PI / 2));
+			case SineEaseInOut:        return float(PI / 2) * sin(x * float(PI));
+			case ExpoEaseIn:           return x == 0 ? 0 : ln2x10 * pow(2, 10 * (x - 1));
+			case ExpoEaseOut:          return x == 1 ? 0 : ln2x10 * pow(2, -10 * x);
+			case ExpoEaseInOut:        return x == 0 || x == 1 ? 0 : ln2x10 * pow(2, x < .5f ? 10 * (2 * x - 1) : -10 * (2 * x - 1));
+			case CircEaseIn:           return circIn(x);
+			case CircEaseOut:          return circIn(1 - x);
+			case CircEaseInOut:        return circIn(x < .5f ? 2 * x : 2 - 2 * x);
+			case BackEaseIn:           return backIn(x, back);
+			case BackEaseOut:          return backIn(1 - x, back);
+			case BackEaseInOut:        return backIn(x < .5f ? 2 * x : 2 - 2 * x, backInOut);
+			case BounceEaseIn:         return bounceOut(1 - x);
+			case BounceEaseOut:        return bounceOut(x);
+			case BounceEaseInOut:      return bounceOut(x < .5f ? 1 - 2 * x : 2 * x - 1);
+			case ElasticEaseIn:
+			case ElasticEaseInFast:    return elasticIn(x - 1, .3f);
+			case ElasticEaseOut:
+			case ElasticEaseOutFast:   return elasticOut(x, .3f);
+			case ElasticEaseInOut:
+			case ElasticEaseInOutFast: return x < .5f ? elasticIn(2 * x - 1, .45f) : elasticOut(2 * x - 1, .45f);
+		}
+		return 1;
+	}
+};
+
+// Slope of the curve a Curve policy evaluates. Policies that are not built on
+// easingType (easeSteppable is false: Bezier, baked and user curves) are
+// differentiated numerically from two nearby values
+template <class Curve, bool Analytic = easeSteppable<Curve>::value> struct easeSlope {
+	static float at(easingType mode, float x) {
+		return easingSlope::slope(mode, x);
+	}
+};
+
+template <class Curve> struct easeSlope<Curve, false> {
+	static float at(easingType mode, float x) {
+		const float h = 1e-3f;
+		float lo = x - h < 0 ? 0 : x - h, hi = x + h > 1 ? 1 : x + h;
+		return (Curve::template calc<float,float>(mode, hi, 0.0f, 1.0f, 1.0f) - Curve::template calc<float,float>(mode, lo, 0.0f, 1.0f, 1.0f)) / (hi - lo);
+	}
+};
+
+// What retargeting a running tween keeps continuous besides the value
+enum retargetMode {
+	RetargetPosition,                                                       // restart the curve from the current value
+	RetargetVelocity,                                                       // also keep the current speed
+};
+
+// Phase in [0, limit] at which to restart a curve so that it continues with a
+// given velocity. Restarted at phase t and run to its end in the time left, the
+// curve moves at f'(t)(1 - t)/(1 - f(t)) times the average speed over the
+// distance left; k is the velocity to keep in those units. Takes the first
+// crossing of k among 8 samples, refined by bisection, or the closest sample
+// when no phase reaches k
+template <class Curve> float easeRetargetPhase(easingType mode, float k, float limit) {
+	struct speed {
+		static float at(easingType mode, float t) {
+			float rest = 1 - Curve::template calc<float,float>(mode, t, 0.0f, 1.0f, 1.0f);
+			if (rest < 1e-3f && rest > -1e-3f) return 1e9f;                 // the curve is at its end there
+			return easeSlope<Curve>::at(mode, t) * (1 - t) / rest;
+		}
+	};
+
+	if (limit > .999f) limit = .999f;
+	if (limit <= 0) return 0;
+
+	float best = 0, bestError = fabs(speed::at(mode, 0) - k);
+	float lo = 0, errorLo = speed::at(mode, 0) - k;
+	for (unsigned char i = 1; i <= 8; i++) {
+		float hi = limit * i / 8, errorHi = speed::at(mode, hi) - k;
+		if (fabs(errorHi) < bestError) { best = hi; bestError = fabs(errorHi); }
+		if ((errorLo <= 0) != (errorHi <= 0)) {
+			for (unsigned char j = 0; j < 10; j++) {
+				float mid = (lo + hi) / 2, errorMid = speed::at(mode, mid) - k;
+				if ((errorLo <= 0) == (errorMid <= 0)) { lo = mid; errorLo = errorMid; } else hi = mid;
+			}
+			return (lo + hi) / 2;
+		}
+		lo = hi;
+		errorLo = errorHi;
+	}
+	return best;
+}
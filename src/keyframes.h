@@ -0,0 +1,329 @@
+/*
+  Keyframes.h - streamed keyframe files played through a single Tween
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "tween.h"
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#endif
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define KEYFRAMES_MMAP
+#endif
+
+// Keyframe file, all numbers little endian (extras/KeyframeConverter writes
+// these from JSON or CSV):
+//
+//   header, 12 bytes     'T' 'W' 'K' 'F', u8 version (1), u8 value format,
+//                        u16 reserved, u32 keyframe count
+//   keyframe, 8 + 2V     u32 time, u8 easingType into the next keyframe,
+//                        u8 reserved, u16 step (0: none), V value, V increment (0: none)
+//
+// where V is the size of the value format: 4 (float), 2 (int16) or 1 (uint8).
+// Keyframes are sorted on time; keyframe i and i + 1 make up segment i.
+// Records have a fixed size, so any keyframe is found without reading the
+// ones before it.
+enum keyframeFormat {
+	KeyframeFloat = 0,
+	KeyframeInt16 = 1,
+	KeyframeUInt8 = 2,
+};
+
+static const uint8_t keyframeHeaderSize = 12;
+static const uint8_t keyframeVersion    = 1;
+
+/*-----------------------------
+         SOURCES
+  -----------------------------*/
+
+// A source hands out bytes at an offset: read(offset, out, size) returns
+// false when the data is not there.
+
+// Keyframe file held in (memory mapped) RAM
+class keyframeMemory
+{
+public:
+	keyframeMemory(const void* data = nullptr, uint32_t size = 0) : data((const uint8_t*)data), bytes(size) {}
+
+	bool read(uint32_t offset, uint8_t* out, uint16_t size) const {
+		if (data == nullptr || offset > bytes || bytes - offset < size) return false;
+		memcpy(out, data + offset, size);
+		return true;
+	}
+
+protected:
+	const uint8_t* data;
+	uint32_t       bytes;
+};
+
+#if defined(__AVR__)
+// Keyframe file compiled into flash with PROGMEM
+class keyframeFlash
+{
+public:
+	keyframeFlash(const void* data, uint32_t size) : data((const uint8_t*)data), bytes(size) {}
+
+	bool read(uint32_t offset, uint8_t* out, uint16_t size) const {
+		if (offset > bytes || bytes - offset < size) return false;
+		memcpy_P(out, data + offset, size);
+		return true;
+	}
+
+private:
+	const uint8_t* data;
+	uint32_t       bytes;
+};
+#endif
+
+// Keyframe file read on demand from anything with seek(position) and
+// read(buffer, size), such as an SD library File. Sequential reads do not seek.
+template <class File> class keyframeStream
+{
+public:
+	keyframeStream(File& file) : file(file), position(0xFFFFFFFF) {}
+
+	bool read(uint32_t offset, uint8_t* out, uint16_t size) {
+		if (offset != position && !file.seek(offset)) { position = 0xFFFFFFFF; return false; }
+		if (uint16_t(file.read(out, size)) != size)   { position = 0xFFFFFFFF; return false; }
+		position = offset + size;
+		return true;
+	}
+
+private:
+	File&    file;
+	uint32_t position;
+};
+
+#if defined(KEYFRAMES_MMAP)
+// Keyframe file memory mapped read-only; pages are loaded by the OS as playback
+// reaches them, so opening does not depend on the length of the show
+class keyframeMap : public keyframeMemory
+{
+public:
+	keyframeMap(const char* path) {
+		int file = ::open(path, O_RDONLY);
+		if (file < 0) return;
+		struct stat info;
+		if (fstat(file, &info) == 0 && info.st_size > 0) {
+			void* mapped = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+			if (mapped != MAP_FAILED) {
+				data  = (const uint8_t*)mapped;
+				bytes = uint32_t(info.st_size);
+			}
+		}
+		::close(file);
+	}
+
+	~keyframeMap() {
+		if (data != nullptr) munmap((void*)data, bytes);
+	}
+
+	bool isOpen() const {
+		return data != nullptr;
+	}
+
+	keyframeMap(const keyframeMap&)            = delete;
+	keyframeMap& operator=(const keyframeMap&) = delete;
+};
+#endif
+
+/*-----------------------------
+         PLAYER
+  -----------------------------*/
+
+// Plays a keyframe file through one Tween, loading a segment only when playback
+// reaches it: opening a show reads just the header, and RAM use does not grow
+// with the number of keyframes.
+//
+//   keyframeMap   file("show.twkf");
+//   KeyframePlayer<float, keyframeMap> show(file);
+//   show.tween().onUpdate(setLevel);
+//   show.seek(now);                    // every frame
+//
+// Moving on to the next segment reads one keyframe; jumps find their segment
+// with a binary search over the keyframe times. After the last keyframe the
+// value holds.
+template <class Tout, class Source> class KeyframePlayer
+{
+
+public:
+	typedef Tween<unsigned long, Tout> TweenType;
+
+	struct Keyframe {
+		uint32_t   time;
+		Tout       value;
+		easingType easing;
+		uint16_t   step;
+		Tout       increment;
+	};
+
+private:
+	static const uint32_t none = 0xFFFFFFFF;
+
+	Source&   source;
+	TweenType player;
+	uint32_t  count;
+	uint8_t   format, valueSize;
+	uint32_t  segment;                                                       // loaded segment, none before the first load
+	Keyframe  current, next;                                                 // ends of the loaded segment
+	bool      held;                                                          // showing the last keyframe
+
+	static uint32_t read32(const uint8_t* data) {
+		return uint32_t(data[0]) | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24;
+	}
+
+	static uint16_t read16(const uint8_t* data) {
+		return uint16_t(data[0] | data[1] << 8);
+	}
+
+	Tout decode(const uint8_t* data) const {
+		switch (format) {
+			case KeyframeInt16: return Tout(int16_t(read16(data)));
+			case KeyframeUInt8: return Tout(data[0]);
+			default: {
+				uint32_t bits = read32(data);
+				float    value;
+				memcpy(&value, &bits, sizeof(value));
+				return Tout(value);
+			}
+		}
+	}
+
+	uint8_t recordSize() const {
+		return 8 + 2 * valueSize;
+	}
+
+	uint32_t offsetOf(uint32_t index) const {
+		return keyframeHeaderSize + index * uint32_t(recordSize());
+	}
+
+	bool timeAt(uint32_t index, uint32_t& time) {
+		uint8_t data[4];
+		if (!source.read(offsetOf(index), data, 4)) return false;
+		time = read32(data);
+		return true;
+	}
+
+	// Last segment that starts at or before now
+	uint32_t find(uint32_t now) {
+		uint32_t lo = 0, hi = count - 2;
+		while (lo < hi) {
+			uint32_t mid = lo + (hi - lo + 1) / 2, time;
+			if (!timeAt(mid, time)) return none;
+			if (time <= now) lo = mid; else hi = mid - 1;
+		}
+		return lo;
+	}
+
+	// Loads segment index into the tween, reusing its start when moving on
+	bool load(uint32_t index) {
+		if (segment != none && index == segment + 1) {
+			current = next;
+		} else if (!keyframe(index, current)) {
+			return false;
+		}
+		if (!keyframe(index + 1, next)) return false;
+		segment = index;
+
+		player.from(current.value).to(next.value).during(next.time - current.time).easing(current.easing);
+		player.step(current.step).increment(current.increment).startAt(current.time);
+		return true;
+	}
+
+public:
+	KeyframePlayer(Source& source) : source(source), count(0), format(0), valueSize(0), segment(none), held(false) {
+		uint8_t header[keyframeHeaderSize];
+		if (!source.read(0, header, keyframeHeaderSize))                                      return;
+		if (header[0] != 'T' || header[1] != 'W' || header[2] != 'K' || header[3] != 'F')    return;
+		if (header[4] != keyframeVersion || header[5] > KeyframeUInt8)                        return;
+		format    = header[5];
+		valueSize = format == KeyframeFloat ? 4 : format == KeyframeInt16 ? 2 : 1;
+		count     = read32(header + 8);
+	}
+
+	// False when the header is missing or of another version
+	bool isValid() const {
+		return valueSize != 0;
+	}
+
+	uint32_t size() const {
+		return count;
+	}
+
+	// Time of the last keyframe
+	uint32_t length() {
+		uint32_t time = 0;
+		if (count != 0) timeAt(count - 1, time);
+		return time;
+	}
+
+	// Reads keyframe index from the source
+	bool keyframe(uint32_t index, Keyframe& out) {
+		uint8_t data[8 + 2 * 4];
+		if (index >= count || !source.read(offsetOf(index), data, recordSize())) return false;
+		out.time      = read32(data);
+		out.easing    = data[4] < easingTypeCount ? easingType(data[4]) : LinearEaseIn;
+		out.step      = read16(data + 6);
+		out.value     = decode(data + 8);
+		out.increment = decode(data + 8 + valueSize);
+		return true;
+	}
+
+	// The reusable tween that plays the current segment, e.g. to set onUpdate()
+	TweenType& tween() {
+		return player;
+	}
+
+	Tout value() {
+		return player.value();
+	}
+
+	// Moves playback to now; true when the tween produced a new value
+	bool seek(unsigned long now) {
+		if (count < 2) return false;
+		bool before = segment != none && now < current.time;
+		bool after  = segment != none && now >= next.time;
+		if (segment == none || (before && segment != 0) || (after && segment + 2 < count)) {
+			if (!(after && load(segment + 1) && now < next.time) && !load(find(now))) return false;
+		}
+		if (now < current.time) return false;                                  // before the first keyframe
+		if (now >= next.time) {                                                // past the last keyframe
+			if (held) return false;
+			held = true;
+			return player.seek(next.time);
+		}
+		held = false;
+		return player.seek(now);
+	}
+
+};
@@ -0,0 +1,140 @@
+/*
+  TweenScheduler.h - wakes tweens only when they are due
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include "tween.h"
+
+// Holds up to N tweens in a min-heap keyed on Tween::nextDue(), so a caller
+// can sleep until nextDeadline() instead of polling every tween each loop.
+// Tweens with step or increment filters are only visited when a new value is
+// possible; unfiltered tweens come back every interval.
+//
+//   TweenScheduler<unsigned long, float, 64> scheduler;
+//   scheduler.add(fade);
+//   scheduler.poll(millis());
+//   sleepUntil(scheduler.nextDeadline());
+//
+// Tweens are dropped from the heap once they reached their end or were
+// stopped; add them again after a restart. Features after N are those of the
+// tweens, e.g. Playback for repeating ones.
+template <class Tin, class Tout, unsigned int N = 16, class... Features> class TweenScheduler
+{
+
+public:
+	typedef Tween<Tin, Tout, easeRuntime, Features...> TweenType;
+
+private:
+	struct entry {
+		TweenType* tween;
+		Tin        due;
+	};
+
+	entry        heap[N];
+	unsigned int count;
+	Tin          interval;
+
+	// Deadlines are clock times and keep their order across the wrap of an
+	// unsigned Tin, as long as they lie within half its range of each other
+	static bool earlier(Tin a, Tin b) {
+		return tweenTime<Tin>::before(a, b);
+	}
+
+	void push(TweenType* tween, Tin due) {
+		unsigned int i = count++;
+		while (i > 0) {
+			unsigned int parent = (i - 1) / 2;
+			if (!earlier(due, heap[parent].due)) break;
+			heap[i] = heap[parent];
+			i       = parent;
+		}
+		heap[i].tween = tween;
+		heap[i].due   = due;
+	}
+
+	entry pop() {
+		entry top  = heap[0];
+		entry last = heap[--count];
+		unsigned int i = 0;
+		for (;;) {
+			unsigned int child = 2 * i + 1;
+			if (child >= count) break;
+			if (child + 1 < count && earlier(heap[child + 1].due, heap[child].due)) child++;
+			if (!earlier(heap[child].due, last.due)) break;
+			heap[i] = heap[child];
+			i       = child;
+		}
+		if (count > 0) heap[i] = last;
+		return top;
+	}
+
+public:
+
+	TweenScheduler() {
+		count    = 0;
+		interval = 1;
+	}
+
+	// Revisit period for tweens without filters, in Tin units
+	TweenScheduler& every(Tin value) {
+		interval = value;
+		return *this;
+	}
+
+	bool add(TweenType& tween) {
+		if (count >= N || !tween.isAnimating()) return false;
+		push(&tween, tween.nextDue());
+		return true;
+	}
+
+	unsigned int size() const {
+		return count;
+	}
+
+	// Time the earliest tween is due; only meaningful when size() > 0
+	Tin nextDeadline() const {
+		return heap[0].due;
+	}
+
+	// Seeks every tween that is due at now and reschedules the ones still running.
+	// Returns the number of tweens that produced a new value
+	unsigned int poll(Tin now) {
+		unsigned int updated = 0;
+		unsigned int visits  = count;                                       // every tween at most once per poll
+		while (count > 0 && visits-- > 0 && !earlier(now, heap[0].due)) {
+			entry e = pop();
+			if (e.tween->seekAt(now)) updated++;
+
+			Tin end = e.tween->endPosition();
+			if (!e.tween->isAnimating() || e.tween->position() == end) continue;
+			Tin due = e.tween->nextDue();
+			if (!earlier(now, due)) due = now + interval;
+			if (Tin(due - now) > Tin(end - now)) due = end;                  // both lie ahead of now, the end may be more than half the range away
+			push(e.tween, due);
+		}
+		return updated;
+	}
+
+};
@@ -0,0 +1,178 @@
+/*
+  Timeline.h - sequences of tweens with random access
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include "tween.h"
+
+// Places up to N tweens on a shared time axis: in sequence (then), in parallel
+// (with), at an absolute time (add, which may overlap) and optionally repeated.
+// Segments are kept sorted on start time and indexed as an implicit interval
+// tree, so seek(t) visits only the segments active at t and the ones it crossed
+// since the previous seek. Those are settled to their end value when t jumped
+// past them and to their start value when t was scrubbed back before them.
+//
+//   Timeline<unsigned int, float, 8> show;
+//   show.then(fadeIn).then(hold, 3).with(blink).then(fadeOut);
+//   show.seek(1234);
+//
+// The timeline drives the tweens through startAt()/seek(), so they should not
+// use timed durations (duringMsec etc.) or their own onUpdate callback. The
+// timeline calls its onUpdate once per segment whose value changed, with the
+// segment number in the order the segments were added.
+template <class Tin, class Tout, unsigned int N = 16> class Timeline
+{
+
+public:
+	typedef Tween<Tin, Tout> TweenType;
+	typedef void(*onUpdateCallback)(unsigned int, Tin, Tout);
+
+private:
+	struct segment {
+		TweenType*   tween;
+		Tin          start, end;                                          // end includes the repeats
+		Tin          maxEnd;                                              // largest end in the subtree below this segment
+		Tout         lastValue;
+		unsigned int id;
+		unsigned int repeats;
+		bool         evaluated;
+	};
+
+	segment      segments[N];
+	unsigned int count;
+	Tin          lastStart, lastEnd;
+	Tin          lastSeek;
+	onUpdateCallback onUpdateCallbackFunction;
+
+	// The segments first..last-1 form a subtree rooted at the middle one, which
+	// holds the largest end time below it. Returns that end time
+	Tin index(unsigned int first, unsigned int last) {
+		unsigned int mid    = (first + last) / 2;
+		Tin          maxEnd = segments[mid].end;
+		if (first < mid)    { Tin end = index(first, mid);    if (end > maxEnd) maxEnd = end; }
+		if (mid + 1 < last) { Tin end = index(mid + 1, last); if (end > maxEnd) maxEnd = end; }
+		segments[mid].maxEnd = maxEnd;
+		return maxEnd;
+	}
+
+	// Evaluates the segments among first..last-1 that overlap from..to at value,
+	// clamped to each segment. Returns true if any of them changed
+	bool visit(unsigned int first, unsigned int last, Tin from, Tin to, Tin value) {
+		if (first >= last) return false;
+		unsigned int mid = (first + last) / 2;
+		segment&     seg = segments[mid];
+		if (seg.maxEnd < from) return false;                              // nothing below reaches from
+
+		bool changed = visit(first, mid, from, to, value);
+		if (seg.start > to) return changed;                               // the segments after it start even later
+		if (seg.end >= from && evaluate(seg, value < seg.start ? seg.start : value > seg.end ? seg.end : value)) changed = true;
+		if (visit(mid + 1, last, from, to, value)) changed = true;
+		return changed;
+	}
+
+	bool evaluate(segment& seg, Tin value) {
+		Tin length = seg.tween->length();
+		Tin local  = value - seg.start;
+		if (local >= seg.end - seg.start) local = length;                  // the end of the last repeat
+		else if (seg.repeats > 1)          local = local - length * Tin((unsigned long)(local / length));
+
+		seg.tween->startAt(0);
+		seg.tween->seek(local);
+		Tout current = seg.tween->value();
+		if (seg.evaluated && current == seg.lastValue) return false;
+
+		seg.evaluated = true;
+		seg.lastValue = current;
+		if (onUpdateCallbackFunction != nullptr) onUpdateCallbackFunction(seg.id, value, current);
+		return true;
+	}
+
+public:
+
+	Timeline() {
+		count                    = 0;
+		lastStart                = 0;
+		lastEnd                  = 0;
+		lastSeek                 = 0;
+		onUpdateCallbackFunction = nullptr;
+	}
+
+	// Places tween at an absolute time, repeated the given number of times
+	Timeline& add(TweenType& tween, Tin at, unsigned int repeats = 1) {
+		if (count >= N) return *this;
+		if (repeats == 0) repeats = 1;
+
+		segment seg;
+		seg.tween     = &tween;
+		seg.start     = at;
+		seg.end       = at + tween.length() * Tin(repeats);
+		seg.id        = count;
+		seg.repeats   = repeats;
+		seg.evaluated = false;
+		seg.lastValue = Tout(0);
+
+		unsigned int i = count++;
+		while (i > 0 && segments[i - 1].start > at) { segments[i] = segments[i - 1]; i--; }
+		segments[i] = seg;
+		index(0, count);
+
+		lastStart = at;
+		if (seg.end > lastEnd) lastEnd = seg.end;
+		return *this;
+	}
+
+	// Starts after everything added so far has finished
+	Timeline& then(TweenType& tween, unsigned int repeats = 1) {
+		return add(tween, lastEnd, repeats);
+	}
+
+	// Starts together with the previously added tween
+	Timeline& with(TweenType& tween, unsigned int repeats = 1) {
+		return add(tween, lastStart, repeats);
+	}
+
+	Timeline& onUpdate(onUpdateCallback value) {
+		onUpdateCallbackFunction = value;
+		return *this;
+	}
+
+	Tin length() const {
+		return lastEnd;
+	}
+
+	unsigned int size() const {
+		return count;
+	}
+
+	// Evaluates the segments active at value and settles the ones crossed since
+	// the previous seek (or since 0 for the first); returns true if any changed
+	bool seek(Tin value) {
+		Tin from = lastSeek < value ? lastSeek : value;
+		Tin to   = lastSeek < value ? value : lastSeek;
+		lastSeek = value;
+		return visit(0, count, from, to, value);
+	}
+
+};
@@ -25,39 +25,321 @@
 */
 #pragma once
 
-#if defined(ARDUINO) && ARDUINO >= 100
-#include "arduino.h"
-#else
-#include "WProgram.h"
-#endif
+#include "tweenclock.h"
 #include "ease.h"
+#include "easeslope.h"
+#include "tweenstats.h"
+
+// How tweened values are eased, blended, compared and composed. Scalars go
+// straight through the curve; multi-lane values (vec.h) specialize this to
+// evaluate the easing factor once and apply it to every lane.
+template <class T> struct tweenValue {
+	template <class Curve, class Tin> static T calc(easingType easeMode, Tin t, T from, T to, Tin d) {
+		return Curve::template calc<Tin,T>(easeMode, t, from, to - from, d);
+	}
+
+	static T mix(T from, T to, float f) {
+		return (to - from) * f + from;
+	}
+
+	static bool within(T a, T b, T limit) {
+		return (a - b) * (a - b) < limit * limit;
+	}
+
+	// The change from b to a, and a moved on by such a change
+	static T difference(T a, T b) {
+		return T(a - b);
+	}
+
+	static T add(T a, T delta) {
+		return T(a + delta);
+	}
 
+	// Change from fromA to toA in units of the change from fromB to toB; 0 when B does not change
+	static float ratio(T fromA, T toA, T fromB, T toB) {
+		float b = float(toB) - float(fromB);
+		return b == 0 ? 0 : (float(toA) - float(fromA)) / b;
+	}
+};
+
+// Features a Tween can do without, listed after Curve to compile out their
+// state, e.g. Tween<unsigned long, float, easeRuntime, NoStepFilter, NoIncrementFilter, NoCallback>.
+// Calling step(), increment() or onUpdate() on a tween that strips them is a
+// compile error.
+struct NoStepFilter {};                                                     // step(), stepMsec(), ...
+struct NoIncrementFilter {};                                                // increment()
+struct NoCallback {};                                                       // onUpdate()
+
+// Features a Tween only carries when listed after Curve, as their state would
+// nearly double the size of a plain tween, e.g.
+// Tween<unsigned long, float, easeRuntime, ForwardStepping, Playback>.
+// Calling repeat(), yoyo(), reverse() or timeScale() without Playback is a
+// compile error.
+struct ForwardStepping {};                                                  // incremental evaluation under equal steps
+struct Playback {};                                                         // repeat(), yoyo(), reverse(), timeScale()
+
+// value is true when Feature is one of Features
+template <class Feature, class... Features> struct tweenLists {
+	static const bool value = false;
+};
+template <class Feature, class... Features> struct tweenLists<Feature, Feature, Features...> {
+	static const bool value = true;
+};
+template <class Feature, class Other, class... Features> struct tweenLists<Feature, Other, Features...> : tweenLists<Feature, Features...> {};
 
-// todo: add relative position
+// State of each optional feature. Tween derives from these, so a stripped
+// feature is an empty base and takes no space.
+template <class Tin, bool Enabled> class tweenStepState {
+protected:
+	Tin stepSize;
 
-#define Ease(EASEMETHOD)  EASEMETHOD ## EaseIn, EASEMETHOD ## EaseOut, EASEMETHOD ## EaseInOut
+	void setStepSize(Tin value)                 { stepSize = value; }
+	bool withinStep(Tin pos, Tin prevPos) const { return (pos < prevPos ? prevPos - pos : pos - prevPos) < stepSize; }
+	Tin  nextStep(Tin prevPos) const            { return prevPos + stepSize; }
+};
 
-enum easingType {
-	Ease(Linear),
-	Ease(Back),
-	Ease(Bounce),
-	Ease(Circ),
-	Ease(Cubic),
-	Ease(Elastic),
-	Ease(Expo),
-	Ease(Quad),
-	Ease(Quart),
-	Ease(Quint),
-	Ease(Sine)
+template <class Tin> class tweenStepState<Tin, false> {
+protected:
+	void setStepSize(Tin)             {}
+	bool withinStep(Tin, Tin) const   { return false; }
+	Tin  nextStep(Tin prevPos) const  { return prevPos; }
 };
 
-template <class Tin, class Tout> class Tween
+template <class Tout, bool Enabled> class tweenIncrementState {
+protected:
+	Tout minIncrement;
+
+	void setMinIncrement(Tout value)                   { minIncrement = value; }
+	bool withinIncrement(Tout val, Tout prevVal) const { return tweenValue<Tout>::within(val, prevVal, minIncrement); }
+};
+
+template <class Tout> class tweenIncrementState<Tout, false> {
+protected:
+	void setMinIncrement(Tout)              {}
+	bool withinIncrement(Tout, Tout) const  { return false; }
+};
+
+template <class Tin, class Tout, bool Enabled> class tweenCallbackState {
+public:
+	typedef void(*onUpdateCallback)(Tin, Tout);
+
+protected:
+	onUpdateCallback onUpdateCallbackFunction;
+
+	void setCallback(onUpdateCallback value) { onUpdateCallbackFunction = value; }
+	bool notify(Tin pos, Tout val) const {
+		if (onUpdateCallbackFunction == nullptr) return false;
+		onUpdateCallbackFunction(pos, val);
+		return true;
+	}
+};
+
+template <class Tin, class Tout> class tweenCallbackState<Tin, Tout, false> {
+public:
+	typedef void(*onUpdateCallback)(Tin, Tout);
+
+protected:
+	void setCallback(onUpdateCallback)  {}
+	bool notify(Tin, Tout) const { return false; }
+};
+
+// Repeats, direction and speed of playback. The position within the current
+// cycle follows from the time elapsed since the start alone, so a long pause
+// or a large update(value) lands in the right cycle at once.
+static const unsigned int tweenForever = 0;
+
+template <class Tin, bool Enabled> class tweenPlaybackState {
+protected:
+	float         scale;
+	unsigned int  cycles;                                                   // tweenForever repeats without end
+	unsigned char yoyoCycles : 1;                                           // every other cycle backwards
+	unsigned char reversed   : 1;
+
+	void resetPlayback() {
+		scale      = 1;
+		cycles     = 1;
+		yoyoCycles = false;
+		reversed   = false;
+	}
+
+	void setCycles(unsigned int value) { cycles = value; }
+	void setYoyo(bool value)           { yoyoCycles = value; }
+	void setReversed(bool value)       { reversed = value; }
+
+	// Playing time after elapsed real time, and back
+	Tin played(Tin elapsed) const { return scale == 1 ? elapsed : Tin(float(elapsed) * scale); }
+	Tin realTime(Tin time) const {
+		if (scale == 1) return time;
+		Tin elapsed = Tin(float(time) / scale);
+		if (Tin(0.5f) == Tin(0) && played(elapsed) < time) elapsed++;       // integer time: the first tick that gets there
+		return elapsed;
+	}
+
+	// Changes the scale and returns the real time after which the new scale has
+	// played as far as the old one after elapsed
+	Tin rescale(Tin elapsed, float value) {
+		Tin time = played(elapsed);
+		scale    = value;
+		return realTime(time);
+	}
+
+	// Sets local to the position within the current cycle after elapsed real
+	// time, mirrored when the cycle plays backwards. Past the last cycle local
+	// is its end and the result false
+	bool playAt(Tin elapsed, Tin duration, Tin& local) const {
+		Tin time = played(elapsed);
+		if (duration == 0) { local = 0; return time == 0; }
+		unsigned long cycle = (unsigned long)(time / duration);
+		local = time - duration * Tin(cycle);
+		bool ended = cycles != tweenForever && (cycle > cycles || (cycle == cycles && local != 0));
+		if (cycles != tweenForever && cycle >= cycles) { cycle = cycles - 1; local = duration; }
+		if (bool(reversed) != (yoyoCycles && cycle % 2 == 1)) local = duration - local;
+		return !ended;
+	}
+
+	// Real time from the start to the end of the last cycle, or of the current
+	// one when repeating forever
+	Tin endAfter(Tin elapsed, Tin duration) const {
+		if (cycles != tweenForever) return realTime(duration * Tin(cycles));
+		unsigned long cycle = duration == 0 ? 0 : (unsigned long)(played(elapsed) / duration);
+		return realTime(duration * Tin(cycle + 1));
+	}
+
+	// Real time left in the current cycle after elapsed
+	Tin cycleLeft(Tin elapsed, Tin duration) const {
+		Tin time = played(elapsed);
+		if (duration == 0) return 0;
+		unsigned long cycle = (unsigned long)(time / duration);
+		if (cycles != tweenForever && cycle >= cycles) return 0;
+		return Tin(realTime(duration * Tin(cycle + 1)) - elapsed);
+	}
+
+	// Rate at which the current cycle runs through the curve: the time scale,
+	// negative when the cycle plays backwards
+	float rate(Tin elapsed, Tin duration) const {
+		unsigned long cycle = duration == 0 ? 0 : (unsigned long)(played(elapsed) / duration);
+		return bool(reversed) != (yoyoCycles && cycle % 2 == 1) ? -scale : scale;
+	}
+};
+
+template <class Tin> class tweenPlaybackState<Tin, false> {
+protected:
+	void resetPlayback()             {}
+	void setCycles(unsigned int)     {}
+	void setYoyo(bool)               {}
+	void setReversed(bool)           {}
+	Tin  rescale(Tin elapsed, float) { return elapsed; }
+
+	bool playAt(Tin elapsed, Tin duration, Tin& local) const {
+		local = elapsed;
+		return !(elapsed > duration);
+	}
+
+	Tin   endAfter(Tin, Tin duration) const           { return duration; }
+	Tin   cycleLeft(Tin elapsed, Tin duration) const  { return elapsed < duration ? Tin(duration - elapsed) : Tin(0); }
+	float rate(Tin, Tin) const                        { return 1; }
+};
+
+// Rest of a curve that is at current at now, with left to go in its cycle, and
+// should end at target instead. The curve restarts at phase 0 from current, or
+// for RetargetVelocity at the phase that keeps the speed (easeRetargetPhase),
+// never starting before the time elapsed so far
+template <class Curve, class Tin, class Tout> struct tweenRetarget {
+	Tin  startPos, duration;
+	Tout startValue;
+
+	// Speed of a curve from from to to, at phase x of duration and run at rate,
+	// in units of the average speed from current to target in left
+	static float speed(easingType easeMode, Tout from, Tout to, Tout current, Tout target, float x, float rate, Tin left, Tin duration) {
+		return tweenValue<Tout>::ratio(from, to, current, target) * rate * easeSlope<Curve>::at(easeMode, x) * float(left) / float(duration);
+	}
+
+	tweenRetarget(easingType easeMode, retargetMode mode, Tin now, Tin elapsed, Tin left, Tout current, Tout target, float speed) {
+		float phase = mode == RetargetVelocity ? easeRetargetPhase<Curve>(easeMode, speed, float(elapsed) / (float(elapsed) + float(left))) : 0;
+		duration = phase == 0 ? left : Tin(float(left) / (1 - phase));
+		if (duration < left)                duration = left;
+		if (Tin(duration - left) > elapsed) duration = Tin(elapsed + left);
+		startPos = Tin(now + left - duration);
+
+		float f = Curve::template calc<Tin,float>(easeMode, Tin(now - startPos), 0.0f, 1.0f, duration);   // as the tween will evaluate it
+		if (f > .999f && f < 1.001f) { startPos = now; duration = left; f = 0; }
+		startValue = f == 0 ? current : tweenValue<Tout>::mix(target, current, 1 / (1 - f));
+	}
+};
+
+// Incremental evaluation of polynomial curves while pos advances in equal steps
+template <class Tin, bool Enabled> class tweenForwardState {
+protected:
+	static const unsigned char forwardResync = 32;                           // exact evaluations bound the drift
+	easeForward   forward;
+	Tin           forwardStep, calcPos;
+	unsigned char forwardLeft;
+
+	void resetForward() {
+		forwardLeft = 0;
+	}
+
+	// Sets f to the easing factor at pos and returns true when pos is one more
+	// equal step from the previous position; false when it must be evaluated exactly
+	bool stepForward(easingType easeMode, Tin pos, Tin startPos, Tin duration, float& f) {
+		if (!(calcPos < pos)) {                                             // backwards, or into a new cycle
+			calcPos     = pos;
+			forwardLeft = 0;
+			forwardStep = 0;
+			return false;
+		}
+		Tin step = pos - calcPos;
+		calcPos  = pos;
+		if (forwardLeft != 0 && step == forwardStep) {
+			forwardLeft--;
+			f = forward.next();
+			return true;
+		}
+		if (step == forwardStep && easeForward::degreeOf(easeMode) != 0) {
+			forwardLeft = forwardResync;
+			f = forward.start(easeMode, float(pos-startPos) / float(duration), float(step) / float(duration));
+			return true;
+		}
+		forwardLeft = 0;
+		forwardStep = step;
+		return false;
+	}
+
+	tweenForwardState() : forwardStep(0), calcPos(0), forwardLeft(0) {}
+};
+
+template <class Tin> class tweenForwardState<Tin, false> {
+protected:
+	void resetForward() {}
+	bool stepForward(easingType, Tin, Tin, Tin, float&) { return false; }
+};
+
+// Curve selects how the easing is evaluated: easeRuntime (default) follows the
+// easingType set with easing(), easeCurve<E> fixes the curve at compile time so
+// the kernel is inlined into seek(), e.g. Tween<unsigned long, float, easeCurve<CubicEaseInOut> >
+// A clock among the Features (tweenclock.h) sets the time source of timed
+// tweens, clockMillis by default.
+// Integer tweens that run on the fixed point kernels and curves that are not
+// steppable (easeSteppable) never carry the forward stepping state, even when
+// ForwardStepping is listed.
+template <class Tin, class Tout, class Curve = easeRuntime, class... Features> class Tween
+	: public tweenForwardState  <Tin,        tweenLists<ForwardStepping,   Features...>::value && !(easeIntegerType<Tin>::value && easeFixedType<Tout>::value) && easeSteppable<Curve>::value>,
+	  public tweenStepState     <Tin,       !tweenLists<NoStepFilter,      Features...>::value>,
+	  public tweenIncrementState<Tout,      !tweenLists<NoIncrementFilter, Features...>::value>,
+	  public tweenCallbackState <Tin, Tout, !tweenLists<NoCallback,        Features...>::value>,
+	  public tweenPlaybackState <Tin,        tweenLists<Playback,          Features...>::value>
 {
 
 public:
 	typedef void(*onUpdateCallback)(Tin, Tout);
+	typedef typename tweenClockOf<Features...>::type clockType;
 
 private:
+	static const bool hasStepFilter      = !tweenLists<NoStepFilter,      Features...>::value;
+	static const bool hasIncrementFilter = !tweenLists<NoIncrementFilter, Features...>::value;
+	static const bool hasCallback        = !tweenLists<NoCallback,        Features...>::value;
+	static const bool hasPlayback        =  tweenLists<Playback,          Features...>::value;
+
 	enum state {
 		started,
 		firstPos,
@@ -67,24 +349,38 @@ private:
 	};
 
 	Tout val, startValue, endValue, prevValue;                            		// actual, origin and destination values
-	Tin duration, stepSize, pos, startPos, prevPos;
-	bool useTime;
-	bool filterSteps;
-	Tout  minIncrement;
-	bool filterIncrement;
-	//bool started;
-	state runState;
-	easingType easeMode;
-	onUpdateCallback onUpdateCallbackFunction;
+	Tin duration, pos, startPos, prevPos;
+	unsigned char runState        : 3;                                      // state
+	unsigned char useTime         : 1;
+	unsigned char filterSteps     : 1;
+	unsigned char filterIncrement : 1;
+	unsigned char wasStarted      : 1;                                      // start() or startAt() called since init()
+	unsigned char easeMode        : 6;                                      // easingType
+#if defined(TWEEN_INSTRUMENT_INSTANCE)
+	tweenCounts   instanceCounts;
+#endif
+
 	void init() {
+		val          = 0;
 		startValue   = 0;
 		endValue     = 1;
 		duration     = 1;
 		startPos     = 0;
-		stepSize     = 0;
+		prevPos      = 0;
 		filterSteps  = false;
+		filterIncrement = false;
 		useTime      = false;
-		runState    = stopped;
+		runState     = stopped;
+		wasStarted   = false;
+		easeMode     = Curve::mode;
+		this->setStepSize(0);
+		this->setMinIncrement(0);
+		this->setCallback(nullptr);
+		this->resetForward();
+		this->resetPlayback();
+#if defined(TWEEN_INSTRUMENT_INSTANCE)
+		instanceCounts.reset();
+#endif
 	}
 
 public:
@@ -94,49 +390,61 @@ public:
     -----------------------------*/
 
 private:
-	void calcValue() {
-		switch (easeMode) {
-			default:
-		case LinearEaseIn:         { val = easing::linearEaseIn    <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case LinearEaseOut:    { val = easing::linearEaseOut   <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case LinearEaseInOut:  { val = easing::linearEaseInOut <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case BackEaseIn:       { val = easing::backEaseIn      <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case BackEaseOut:      { val = easing::backEaseOut     <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case BackEaseInOut:    { val = easing::backEaseInOut   <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case BounceEaseIn:     { val = easing::bounceEaseIn    <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case BounceEaseOut:    { val = easing::bounceEaseOut   <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case BounceEaseInOut:  { val = easing::bounceEaseInOut <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case CircEaseIn:       { val = easing::circEaseIn      <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case CircEaseOut:      { val = easing::circEaseOut     <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case CircEaseInOut:    { val = easing::circEaseInOut   <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case CubicEaseIn:      { val = easing::cubicEaseIn     <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case CubicEaseOut:     { val = easing::cubicEaseOut    <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case CubicEaseInOut:   { val = easing::cubicEaseInOut  <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case ElasticEaseIn:    { val = easing::elasticEaseIn   <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case ElasticEaseOut:   { val = easing::elasticEaseOut  <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case ElasticEaseInOut: { val = easing::elasticEaseInOut<Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case ExpoEaseIn:       { val = easing::expoEaseIn      <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case ExpoEaseOut:      { val = easing::expoEaseOut     <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case ExpoEaseInOut:    { val = easing::expoEaseInOut   <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case QuadEaseIn:       { val = easing::quadEaseIn      <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case QuadEaseOut:      { val = easing::quadEaseOut     <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case QuadEaseInOut:    { val = easing::quadEaseInOut   <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case QuartEaseIn:      { val = easing::quartEaseIn     <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case QuartEaseOut:     { val = easing::quartEaseOut    <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case QuartEaseInOut:   { val = easing::quartEaseInOut  <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case QuintEaseIn:      { val = easing::quintEaseIn     <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case QuintEaseOut:     { val = easing::quintEaseOut    <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case QuintEaseInOut:   { val = easing::quintEaseInOut  <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case SineEaseIn:       { val = easing::sineEaseIn      <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case SineEaseOut:      { val = easing::sineEaseOut     <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
-			case SineEaseInOut:    { val = easing::sineEaseInOut   <Tin,Tout>(pos-startPos,startValue,endValue-startValue,duration); break; }
+	// The curve evaluated and stepped forward: easeMode for easeRuntime, otherwise
+	// the one fixed by the Curve template parameter
+	easingType curveMode() const {
+		return easeRuntimeMode<Curve>::value ? easingType(easeMode) : easingType(Curve::mode);
+	}
+
+	// Evaluates the curve at local, the position within the current cycle
+	void calcValue(Tin local) {
+		float factor;
+		if (this->stepForward(curveMode(), local, Tin(0), duration, factor)) {
+			TWEEN_COUNT(forwardSteps);
+			val = tweenValue<Tout>::mix(startValue, endValue, factor);
+			return;
+		}
+		TWEEN_COUNT(evaluations);
+		TWEEN_CURVE_BEGIN();
+		val = tweenValue<Tout>::template calc<Curve,Tin>(curveMode(),local,startValue,endValue,duration);
+		TWEEN_CURVE_END(curveMode());
+	}
+
+
+	bool movedEnough(Tin value) const {
+		return !this->withinIncrement(valueAt(value), prevValue);
+	}
+
+	// Scans ahead in 8 blocks for the first one in which the value has moved by
+	// minIncrement, then bisects within it; curves need not be monotonic
+	Tin incrementDue(Tin end) const {
+		Tin lo = pos, hi = end, block = (end - pos) / 8;
+		if (block == 0) return end;
+		for (unsigned char k = 1; k <= 8; k++) {
+			Tin probe = k == 8 ? end : pos + block * k;
+			if (movedEnough(probe)) { hi = probe; break; }
+			if (k == 8) return end;
+			lo = probe;
 		}
+		for (unsigned char k = 0; k < 16; k++) {
+			Tin mid = lo + (hi - lo) / 2;
+			if (mid == lo || mid == hi) break;
+			if (movedEnough(mid)) hi = mid; else lo = mid;
+		}
+		return hi;
 	}
 
+	// Timed tweens compare positions on the clock modulo its wrap around, and only
+	// until the first accepted position: from then on the time since the start only
+	// counts forward, so tweens longer than half the clock range play to the end
+	bool before(Tin a, Tin b) const {
+		if (!useTime) return a < b;
+		return runState == state::started && tweenTime<Tin>::before(a, b);
+	}
 
 	void invokeCallback()
 	{
-		if (onUpdateCallbackFunction != nullptr) onUpdateCallbackFunction(pos,val);
+		if (this->notify(pos,val)) { TWEEN_COUNT(callbacks); }
 	}
 public:
 
@@ -148,6 +456,12 @@ public:
 		return val;
 	}
 
+	// How far the value has moved from the start; what the tween adds to a
+	// target as an additive layer (tweenmixer.h)
+	Tout delta() const {
+		return tweenValue<Tout>::difference(val, startValue);
+	}
+
 	Tween& from(Tout value) {
 		startValue = value;
 		return *this;
@@ -158,75 +472,171 @@ public:
 		return *this;
 	}
 
+	// Ends value away from the start, so call it after from()
+	Tween& by(Tout value) {
+		endValue = tweenValue<Tout>::add(startValue, value);
+		return *this;
+	}
+
 	Tween& during(Tin value) {
-		duration = value;
+		duration    = value;
+		this->resetForward();
+		return *this;
+	}
+
+	Tween& duringUsec(Tin value) {
+		useTime     = true;
+		duration    = tweenTicks<clockType>::fromUsec(value);
+		this->resetForward();
 		return *this;
 	}
 
 	Tween& duringMsec(Tin value) {
-		useTime = true;
-		duration = value;
+		useTime     = true;
+		duration    = tweenTicks<clockType>::fromMsec(value);
+		this->resetForward();
 		return *this;
 	}
 
-	Tween& duringSec   (Tin value) { return duringMsec(                     1000 * value); }
-	Tween& duringMin   (Tin value) { return duringMsec(                60 * 1000 * value); }	
-	Tween& duringHour  (Tin value) { return duringMsec(           60 * 60 * 1000 * value); }
-	Tween& duringDay   (Tin value) { return duringMsec(      24 * 60 * 60 * 1000 * value); }
-	Tween& duringWeek  (Tin value) { return duringMsec(  7 * 24 * 60 * 60 * 1000 * value); }
+	// Whole units are multiplied in Tin, so their range is that of Tin in
+	// milliseconds: 49.7 days in 32 bits, beyond that use a 64-bit Tin
+	Tween& duringSec   (Tin value) { return duringMsec(Tin(1000UL)      * value); }
+	Tween& duringMin   (Tin value) { return duringMsec(Tin(60000UL)     * value); }	
+	Tween& duringHour  (Tin value) { return duringMsec(Tin(3600000UL)   * value); }
+	Tween& duringDay   (Tin value) { return duringMsec(Tin(86400000UL)  * value); }
+	Tween& duringWeek  (Tin value) { return duringMsec(Tin(604800000UL) * value); }
 
 
 	Tween& step(Tin value) {
-		stepSize = value;
+		static_assert(hasStepFilter, "step() is not available on a Tween with NoStepFilter");
+		this->setStepSize(value);
+		filterSteps = true;
+		return *this;
+	}
+
+	Tween& stepUsec(Tin value) {
+		static_assert(hasStepFilter, "stepUsec() is not available on a Tween with NoStepFilter");
+		useTime     = true;
+		this->setStepSize(tweenTicks<clockType>::fromUsec(value));
 		filterSteps = true;
 		return *this;
 	}
 
 	Tween& stepMsec(Tin value) {
+		static_assert(hasStepFilter, "stepMsec() is not available on a Tween with NoStepFilter");
 		useTime     = true;
-		stepSize    = value;
+		this->setStepSize(tweenTicks<clockType>::fromMsec(value));
 		filterSteps = true;
 		return *this;
 	}
 
-	Tween& stepSec   (Tin value) { return stepMsec(                     1000 * value); }
-	Tween& stepMin   (Tin value) { return stepMsec(                60 * 1000 * value); }	
-	Tween& stepHour  (Tin value) { return stepMsec(           60 * 60 * 1000 * value); }
-	Tween& stepDay   (Tin value) { return stepMsec(      24 * 60 * 60 * 1000 * value); }
-	Tween& stepWeek  (Tin value) { return stepMsec(  7 * 24 * 60 * 60 * 1000 * value); }
+	Tween& stepSec   (Tin value) { return stepMsec(Tin(1000UL)      * value); }
+	Tween& stepMin   (Tin value) { return stepMsec(Tin(60000UL)     * value); }	
+	Tween& stepHour  (Tin value) { return stepMsec(Tin(3600000UL)   * value); }
+	Tween& stepDay   (Tin value) { return stepMsec(Tin(86400000UL)  * value); }
+	Tween& stepWeek  (Tin value) { return stepMsec(Tin(604800000UL) * value); }
 
 	Tween& increment(Tout value) {
-		minIncrement   = value;
+		static_assert(hasIncrementFilter, "increment() is not available on a Tween with NoIncrementFilter");
+		this->setMinIncrement(value);
 		filterIncrement = true;
 		return *this;
 	}
 
+	// Has no effect when the curve is fixed by the Curve template parameter
 	Tween& easing(easingType value) {
-		easeMode = value;
+		if (!easeRuntimeMode<Curve>::value) return *this;
+		easeMode    = value;
+		this->resetForward();
+		return *this;
+	}
+
+	// Plays the tween times times in a row, without end for tweenForever
+	template <bool Enabled = hasPlayback> Tween& repeat(unsigned int times) {
+		static_assert(Enabled, "repeat() needs a Tween with Playback");
+		this->setCycles(times);
+		return *this;
+	}
+
+	// Plays every other repeat backwards, from the end value to the start value
+	template <bool Enabled = hasPlayback> Tween& yoyo(bool value = true) {
+		static_assert(Enabled, "yoyo() needs a Tween with Playback");
+		this->setYoyo(value);
+		this->resetForward();
+		return *this;
+	}
+
+	// Plays from the end value to the start value
+	template <bool Enabled = hasPlayback> Tween& reverse(bool value = true) {
+		static_assert(Enabled, "reverse() needs a Tween with Playback");
+		this->setReversed(value);
+		this->resetForward();
+		return *this;
+	}
+
+	// Plays value times as fast, so a cycle takes duration / value. A running
+	// timed tween continues from where it is; an untimed tween is rescaled
+	// from its start, so seek() keeps mapping a position to a single value
+	template <bool Enabled = hasPlayback> Tween& timeScale(float value) {
+		static_assert(Enabled, "timeScale() needs a Tween with Playback");
+		if (useTime && runState == state::intermediatePos) startPos = pos - this->rescale(Tin(pos - startPos), value);
+		else                                               this->rescale(Tin(0), value);
+		this->resetForward();
+		return *this;
+	}
+
+	// Sends a running tween to value without a jump: the curve restarts from
+	// the current value and still ends when the current cycle would have.
+	// RetargetVelocity also keeps the current speed, from the slope of the
+	// easing (easeslope.h). Repeats, yoyo, reverse and time scale end with the
+	// current cycle. Before the tween is under way this is to()
+	Tween& retarget(Tout value, retargetMode mode = RetargetPosition) {
+		Tin elapsed = Tin(pos - startPos);
+		Tin left    = this->cycleLeft(elapsed, duration);
+		if (runState != state::intermediatePos || left == 0) return to(value);
+
+		float speed = 0;
+		if (mode == RetargetVelocity) {
+			Tin local;
+			this->playAt(elapsed, duration, local);
+			speed = tweenRetarget<Curve,Tin,Tout>::speed(curveMode(), startValue, endValue, val, value, float(local) / float(duration), this->rate(elapsed, duration), left, duration);
+		}
+		tweenRetarget<Curve,Tin,Tout> rest(curveMode(), mode, pos, elapsed, left, val, value, speed);
+
+		startPos   = rest.startPos;
+		duration   = rest.duration;
+		startValue = rest.startValue;
+		endValue   = value;
+		this->resetPlayback();
+		this->resetForward();
 		return *this;
 	}
 
 	Tween& onUpdate(onUpdateCallback value) {
-		onUpdateCallbackFunction = value;
+		static_assert(hasCallback, "onUpdate() is not available on a Tween with NoCallback");
+		this->setCallback(value);
 		return *this;
 	}
 
 	Tween& start() {
-		runState = state::started;
-		//started = true;
+		runState   = state::started;
+		wasStarted = true;
 		if (useTime) { 
-			startPos = Tin(millis());
+			startPos = Tin(clockType::now());
 		} else {
 			startPos = 0;
 		}
 		pos = 0;
+		this->resetForward();
 		return *this;
 	}
 
 	Tween& startAt(Tin value) {
-		runState = state::started;
-		startPos = value;
-		pos      = 0;
+		runState   = state::started;
+		wasStarted = true;
+		startPos   = value;
+		pos        = 0;
+		this->resetForward();
 		return *this;
 	}
 
@@ -240,6 +650,12 @@ public:
 		return runState != state::stopped;
 	}
 
+	// True once start() or startAt() has been called, also after the tween stopped
+	bool hasStarted() const
+	{
+		return wasStarted;
+	}
+
 	bool update() {
 		return seek(pos);
 	}
@@ -248,39 +664,118 @@ public:
 		return seek(pos+value);
 	}
 
+	// Seeks to value, or for a timed tween to the time its clock reads now
 	bool seek(Tin value) {
-		// todo: allow for time overload
-
-		if (runState == state::stopped)   { return false;          }
-		if (useTime)                      { value = Tin(millis()); }
-		if (value < startPos)             { return false;          }				
-		if (value > startPos + duration)  { runState = state::stopped;  return false; }
+		if (useTime && runState != state::stopped) value = Tin(clockType::now());
+		return seekAt(value);
+	}
 
-		pos     = value;
+	// Seeks to value, also for a timed tween: value is the current time of its
+	// clock, read by the caller once for a whole frame of tweens (see seekAll)
+	bool seekAt(Tin value) {
+		TWEEN_COUNT(seeks);
+		if (runState == state::stopped)   { TWEEN_REJECT(RejectStopped);     return false; }
+		if (before(value, startPos))      { TWEEN_REJECT(RejectBeforeStart); return false; }
+		Tin elapsed = Tin(value - startPos), local;                             // elapsed wraps around with the clock
+		if (!this->playAt(elapsed, duration, local)) { TWEEN_REJECT(RejectPastEnd); runState = state::stopped;  return false; }
+
+		pos      = value;
+		runState = state::intermediatePos;
 		
-		if (value == startPos)                                                                      { val = startValue; prevPos = pos; prevValue = val; invokeCallback(); return true;  }
-		if (value == startPos + duration)                                                           { val = endValue  ; prevPos = pos; prevValue = val; invokeCallback(); return true;  }
+		if (local == 0)                                                                             { val = startValue; prevPos = pos; prevValue = val; TWEEN_COUNT(updates); invokeCallback(); return true;  }
+		if (local == duration)                                                                      { val = endValue  ; prevPos = pos; prevValue = val; TWEEN_COUNT(updates); invokeCallback(); return true;  }
 
-		calcValue();
-		if (filterSteps     && ((pos -prevPos   )*(pos - prevPos  ) < stepSize * stepSize))         { return false; }
+		calcValue(local);
+		if (filterSteps     && this->withinStep(pos, prevPos))                                      { TWEEN_REJECT(RejectStep);      return false; }
 		prevPos = pos;
-		if (filterIncrement && ((val - prevValue)*(val - prevValue) < minIncrement * minIncrement)) { return false; }
+		if (filterIncrement && this->withinIncrement(val, prevValue))                               { TWEEN_REJECT(RejectIncrement); return false; }
 		prevValue = val;
+		TWEEN_COUNT(updates);
 		invokeCallback();
 		return true;
 	}
 
+#if defined(TWEEN_INSTRUMENT_INSTANCE)
+	// Instrumentation counters of this tween (tweenstats.h)
+	const tweenCounts& counts() const
+	{
+		return instanceCounts;
+	}
+
+#endif
 	Tin position() const
 	{
 		return pos;
 	}
 
+	// Length of a single cycle
+	Tin length() const
+	{
+		return duration;
+	}
+
+	// End of the last cycle, or of the current one when repeating forever
+	Tin endPosition() const
+	{
+		return startPos + this->endAfter(Tin(pos - startPos), duration);
+	}
+
+	// Value the curve has at position value, without moving the tween
+	Tout valueAt(Tin value) const
+	{
+		Tin local;
+		this->playAt(Tin(value - startPos), duration, local);
+		return tweenValue<Tout>::template calc<Curve,Tin>(curveMode(),local,startValue,endValue,duration);
+	}
+
+	// Earliest position at which seek() can produce a new value: the start, the
+	// next step when filtering steps, the first position where the value has moved
+	// by minIncrement when filtering increments, and never later than the end.
+	// Without filters this is the current position.
+	Tin nextDue() const
+	{
+		Tin end = endPosition();
+		if (runState == state::started || before(pos, startPos)) return startPos;
+		Tin due = pos;
+		if (filterSteps)     { due = this->nextStep(prevPos); }
+		if (filterIncrement) { Tin moved = incrementDue(end); if (Tin(moved - startPos) > Tin(due - startPos)) due = moved; }
+		return Tin(due - startPos) < Tin(end - startPos) ? due : end;
+	}
+
 #pragma warning(pop)
 
 };
 
 #define TweenTime(Tout) Tween <unsigned long, Tout>
 
+// Seeks every tween to now with seekAt(), so the clock is read once per frame
+// instead of once per tween. Returns the number of tweens that produced a new value
+template <class TweenT, class Tnow> unsigned int seekAll(TweenT* tweens, unsigned int count, Tnow now) {
+	unsigned int updated = 0;
+	for (unsigned int i = 0; i < count; i++) {
+		if (tweens[i].seekAt(now)) updated++;
+	}
+	return updated;
+}
+
+template <class TweenT, unsigned int N, class Tnow> unsigned int seekAll(TweenT (&tweens)[N], Tnow now) {
+	return seekAll(tweens, N, now);
+}
+
+// As above, with now read from the clock of the tweens
+template <class TweenT, unsigned int N> unsigned int seekAll(TweenT (&tweens)[N]) {
+	return seekAll(tweens, N, TweenT::clockType::now());
+}
+
+// Retargets every tween to the matching entry of targets in one pass
+template <class TweenT, class Tval> void retargetAll(TweenT* tweens, const Tval* targets, unsigned int count, retargetMode mode = RetargetPosition) {
+	for (unsigned int i = 0; i < count; i++) tweens[i].retarget(targets[i], mode);
+}
+
+template <class TweenT, unsigned int N, class Tval> void retargetAll(TweenT (&tweens)[N], const Tval (&targets)[N], retargetMode mode = RetargetPosition) {
+	retargetAll(tweens, targets, N, mode);
+}
+
 /*-----------------------------
      EXPLICIT DECLARATION
   -----------------------------*/
@@ -294,5 +789,60 @@ template class Tween<unsigned long, unsigned long>;
 template class Tween<unsigned long, float>;
 template class Tween<float, unsigned long>;
 template class Tween<unsigned long, double>;
+template class Tween<unsigned long long, float>;
 template class Tween<float, float>;
 template class Tween<double, double>;
+
+/*-----------------------------
+        LAYOUT CHECKS
+  -----------------------------*/
+
+// With every feature stripped a Tween holds four values, four positions and
+// two bytes of packed flags. Each feature may add no more than its own state,
+// padded to the strictest alignment among all members
+constexpr unsigned int tweenPadded(unsigned int bytes, unsigned int align) { return (bytes + align - 1) / align * align; }
+constexpr unsigned int tweenMax(unsigned int a, unsigned int b)            { return a > b ? a : b; }
+
+template <class Tin, class Tout> struct tweenLayout {
+	typedef void(*callback)(Tin, Tout);
+	typedef tweenForwardState<Tin, true> forwardState;
+	typedef tweenPlaybackState<Tin, true> playbackState;
+
+	static const unsigned int raw       = 4 * sizeof(Tout) + 4 * sizeof(Tin) + 2;
+	static const unsigned int core      = tweenPadded(raw, tweenMax(alignof(Tin), alignof(Tout)));
+	static const unsigned int align     = tweenMax(tweenMax(tweenMax(alignof(Tin), alignof(Tout)), tweenMax(alignof(callback), alignof(forwardState))), alignof(playbackState));
+	static const unsigned int step      = tweenPadded(sizeof(Tin), align);
+	static const unsigned int increment = tweenPadded(sizeof(Tout), align);
+	static const unsigned int onUpdate  = tweenPadded(sizeof(callback), align);
+	static const unsigned int forward   = tweenPadded(sizeof(forwardState), align);
+	static const unsigned int playback  = tweenPadded(sizeof(playbackState), align);
+
+	static constexpr unsigned int with(unsigned int features) { return tweenPadded(raw + features, align); }
+};
+
+#define TweenCheckLayout(TIN, TOUT) \
+	static_assert(sizeof(Tween<TIN, TOUT, easeRuntime, NoStepFilter, NoIncrementFilter, NoCallback>)                  == tweenLayout<TIN, TOUT>::core                                   , "Tween<" #TIN ", " #TOUT "> without features"); \
+	static_assert(sizeof(Tween<TIN, TOUT, easeRuntime,               NoIncrementFilter, NoCallback>)                  <= tweenLayout<TIN, TOUT>::with(tweenLayout<TIN, TOUT>::step)     , "Tween<" #TIN ", " #TOUT "> with step filter"); \
+	static_assert(sizeof(Tween<TIN, TOUT, easeRuntime, NoStepFilter,                    NoCallback>)                  <= tweenLayout<TIN, TOUT>::with(tweenLayout<TIN, TOUT>::increment), "Tween<" #TIN ", " #TOUT "> with increment filter"); \
+	static_assert(sizeof(Tween<TIN, TOUT, easeRuntime, NoStepFilter, NoIncrementFilter            >)                  <= tweenLayout<TIN, TOUT>::with(tweenLayout<TIN, TOUT>::onUpdate) , "Tween<" #TIN ", " #TOUT "> with callback"); \
+	static_assert(sizeof(Tween<TIN, TOUT, easeRuntime, NoStepFilter, NoIncrementFilter, NoCallback, ForwardStepping>) <= tweenLayout<TIN, TOUT>::with(tweenLayout<TIN, TOUT>::forward)  , "Tween<" #TIN ", " #TOUT "> with forward stepping"); \
+	static_assert(sizeof(Tween<TIN, TOUT, easeRuntime, NoStepFilter, NoIncrementFilter, NoCallback, Playback>)        <= tweenLayout<TIN, TOUT>::with(tweenLayout<TIN, TOUT>::playback) , "Tween<" #TIN ", " #TOUT "> with playback"); \
+	static_assert(sizeof(Tween<TIN, TOUT>) <= tweenLayout<TIN, TOUT>::with(tweenLayout<TIN, TOUT>::step + tweenLayout<TIN, TOUT>::increment + tweenLayout<TIN, TOUT>::onUpdate), "Tween<" #TIN ", " #TOUT "> by default carries only the filters and callback"); \
+	static_assert(sizeof(Tween<TIN, TOUT, easeRuntime, ForwardStepping, Playback>) <= tweenLayout<TIN, TOUT>::with(tweenLayout<TIN, TOUT>::step + tweenLayout<TIN, TOUT>::increment + tweenLayout<TIN, TOUT>::onUpdate + tweenLayout<TIN, TOUT>::forward + tweenLayout<TIN, TOUT>::playback), "Tween<" #TIN ", " #TOUT "> with every feature");
+
+#if !defined(TWEEN_INSTRUMENT_INSTANCE)
+TweenCheckLayout(unsigned char, char)
+TweenCheckLayout(unsigned char, unsigned char)
+TweenCheckLayout(unsigned int, int)
+TweenCheckLayout(unsigned int, unsigned int)
+TweenCheckLayout(unsigned long, long)
+TweenCheckLayout(unsigned long, unsigned long)
+TweenCheckLayout(unsigned long, float)
+TweenCheckLayout(float, unsigned long)
+TweenCheckLayout(unsigned long, double)
+TweenCheckLayout(unsigned long long, float)
+TweenCheckLayout(float, float)
+TweenCheckLayout(double, double)
+#endif
+
+#undef TweenCheckLayout
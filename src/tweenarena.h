@@ -0,0 +1,172 @@
+/*
+  TweenArena.h - fixed-capacity storage for short-lived tweens
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include "tween.h"
+
+// Fixed-capacity storage for N tweens that are spawned and discarded at run
+// time, without heap allocation. acquire() and release() are O(1) through a
+// free list that is threaded through the free slots themselves, so it costs
+// no memory beyond the N tweens. Tweens are addressed through handles that carry
+// the slot's generation, so a handle to a recycled slot resolves to nullptr
+// instead of to the tween that took its place.
+//
+//   TweenArena<unsigned long, float, 16> fades;
+//   TweenArena<unsigned long, float, 16>::Handle fade = fades.acquire();
+//   if (Tween<unsigned long, float>* t = fades.get(fade)) t->from(0).to(255).duringMsec(300).onUpdate(setLed).start();
+//   fades.updateAll();                                       // in loop()
+//
+// updateAll() releases a tween once it has stopped after being started,
+// whether it ran to its end or stop() was called, also when that happened
+// before the first updateAll(). A tween that is acquired but never started
+// has to be released by hand. highWaterMark() reports the most tweens
+// that were live at once, to size N from measurements.
+template <class Tin, class Tout, unsigned int N, class Curve = easeRuntime> class TweenArena
+{
+
+public:
+	typedef Tween<Tin, Tout, Curve> tween;
+
+	struct Handle {
+		unsigned int index;
+		unsigned int generation;
+
+		bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+		bool operator!=(const Handle& other) const { return !(*this == other); }
+	};
+
+	// Handle that never resolves; returned by acquire() when the arena is full
+	static Handle none() {
+		Handle handle = { N, 0 };
+		return handle;
+	}
+
+private:
+	static const unsigned int endOfList = N;
+
+	// A live slot holds a tween, a free one the index of the next free slot
+	union Slot {
+		tween        object;
+		unsigned int next;
+
+		Slot() : next(0) {}
+	};
+
+	Slot          slot[N];
+	unsigned int  generation[N];                                           // odd while the slot is live
+	unsigned int  freeList;
+	unsigned int  live, highWater;
+
+	bool isLive(unsigned int i) const {
+		return (generation[i] & 1) != 0;
+	}
+
+	void recycle(unsigned int i) {
+		generation[i]++;
+		slot[i].next = freeList;
+		freeList     = i;
+		live--;
+	}
+
+	template <class Advance> void advanceAll(Advance advance) {
+		for (unsigned int i = 0; i < N; i++) {
+			if (!isLive(i)) continue;
+			tween& t = slot[i].object;
+			if (t.isAnimating()) advance(t);
+			if (!t.isAnimating() && t.hasStarted()) recycle(i);
+		}
+	}
+
+	struct Update {
+		void operator()(tween& t) const { t.update(); }
+	};
+
+	struct UpdateBy {
+		Tin value;
+		void operator()(tween& t) const { t.update(value); }
+	};
+
+	struct SeekTo {
+		Tin value;
+		void operator()(tween& t) const { t.seekAt(value); }
+	};
+
+public:
+
+	TweenArena() {
+		for (unsigned int i = 0; i < N; i++) {
+			generation[i] = 0;
+			slot[i].next  = i + 1;                                         // last slot links to endOfList
+		}
+		freeList  = 0;
+		live      = 0;
+		highWater = 0;
+	}
+
+	// Takes a slot off the free list and resets it to a fresh, stopped tween.
+	// Returns none() when all N slots are live
+	Handle acquire() {
+		if (freeList == endOfList) return none();
+		unsigned int i = freeList;
+		freeList       = slot[i].next;
+		slot[i].object = tween();
+		generation[i]++;
+		if (++live > highWater) highWater = live;
+		Handle handle = { i, generation[i] };
+		return handle;
+	}
+
+	// Returns the slot to the free list; stale handles are ignored
+	void release(Handle handle) {
+		if (get(handle) != nullptr) recycle(handle.index);
+	}
+
+	// The tween a handle refers to, or nullptr once it has been released or recycled
+	tween* get(Handle handle) {
+		if (handle.index >= N || generation[handle.index] != handle.generation || !isLive(handle.index)) return nullptr;
+		return &slot[handle.index].object;
+	}
+
+	bool contains(Handle handle) {
+		return get(handle) != nullptr;
+	}
+
+	// Advances all live tweens with update(), update(value) or seekAt(value)
+	// and recycles the ones that have stopped. seekAll(millis()) reads the
+	// clock once for all timed tweens
+	void updateAll()           { advanceAll(Update());              }
+	void updateAll(Tin value)  { UpdateBy by = { value }; advanceAll(by); }
+	void seekAll(Tin value)    { SeekTo to = { value };   advanceAll(to); }
+
+	unsigned int size() const          { return live;      }
+	unsigned int capacity() const      { return N;         }
+	unsigned int highWaterMark() const { return highWater; }
+
+	void resetHighWaterMark() {
+		highWater = live;
+	}
+
+};
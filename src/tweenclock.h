@@ -0,0 +1,167 @@
+/*
+  TweenClock.h - time sources for timed tweens
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#elif defined(ARDUINO)
+#include "WProgram.h"
+#else
+#include <chrono>
+#endif
+
+// Clocks that timed tweens (duringMsec(), stepMsec(), ...) read their position
+// from. A clock derives from tweenClock, returns its time in ticks from now()
+// and gives the length of a tick in microseconds. It is selected by listing it
+// among the Tween features:
+//
+//   Tween<unsigned long, float>                             fade;   // millis()
+//   Tween<unsigned long, float, easeRuntime, clockMicros>   motor;  // micros()
+//   Tween<unsigned long, float, easeRuntime, clockFrame<> > sprite; // clockFrame<>::set(frameTime)
+//
+// Without the Arduino core, millis and micros are taken from
+// std::chrono::steady_clock, so the same sketch code runs on the host.
+struct tweenClock {};
+
+#if defined(ARDUINO)
+struct clockMillis : tweenClock {
+	static const unsigned long usecPerTick = 1000;
+	static unsigned long now() { return millis(); }
+};
+
+struct clockMicros : tweenClock {
+	static const unsigned long usecPerTick = 1;
+	static unsigned long now() { return micros(); }
+};
+#else
+struct clockSteady : tweenClock {
+	static const unsigned long usecPerTick = 1;
+	static unsigned long now() {
+		return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+};
+
+struct clockMillis : tweenClock {
+	static const unsigned long usecPerTick = 1000;
+	static unsigned long now() {
+		return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+};
+
+struct clockMicros : clockSteady {};
+#endif
+
+// Widens a clock that wraps around after Bits bits to 64 bits, e.g. to run
+// tweens for longer than the 49.7 days after which millis() wraps:
+//
+//   Tween<unsigned long long, float, easeRuntime, clockMillis64> dimmer;
+//
+// A wrap is detected when the clock reads less than the time before, so it
+// has to be read at least once per wrap period. A running timed tween does so
+// on every update.
+template <class Clock, unsigned int Bits = 8 * sizeof(unsigned long)> struct clockExtended : tweenClock {
+	static const unsigned long usecPerTick = Clock::usecPerTick;
+
+	static unsigned long long now() {
+		static unsigned long long high = 0;
+		static unsigned long      last = 0;
+		unsigned long low = Clock::now();
+		if (low < last) high += Bits < 64 ? 1ULL << (Bits % 64) : 0;
+		last = low;
+		return high + low;
+	}
+};
+
+typedef clockExtended<clockMillis> clockMillis64;
+typedef clockExtended<clockMicros> clockMicros64;
+
+// Time set by the application, e.g. the presentation time of the frame being
+// drawn or a simulated clock. Every tween on this clock sees the same time
+// until the next set(), however long the frame takes to compute
+template <unsigned long UsecPerTick = 1000> struct clockFrame : tweenClock {
+	static const unsigned long usecPerTick = UsecPerTick;
+
+	static unsigned long now()           { return current(); }
+	static void set(unsigned long value) { current() = value; }
+
+private:
+	static unsigned long& current() {
+		static unsigned long value = 0;
+		return value;
+	}
+};
+
+// value is true when T is a clock
+template <class T> struct tweenIsClock {
+	static char test(const tweenClock*);
+	static long test(...);
+	static const bool value = sizeof(test((const T*)0)) == 1;
+};
+
+template <bool Condition, class Then, class Else> struct tweenSelect {
+	typedef Then type;
+};
+template <class Then, class Else> struct tweenSelect<false, Then, Else> {
+	typedef Else type;
+};
+
+// First clock among Features, clockMillis when there is none
+template <class... Features> struct tweenClockOf {
+	typedef clockMillis type;
+};
+template <class Feature, class... Features> struct tweenClockOf<Feature, Features...> {
+	typedef typename tweenSelect<tweenIsClock<Feature>::value, Feature, typename tweenClockOf<Features...>::type>::type type;
+};
+
+// Comparisons of times on a clock that wraps around. An unsigned time is
+// before another when it lies less than half the range of T behind it, so a
+// start scheduled up to half the range ahead (24.8 days for millis() and 35.8
+// minutes for micros() in 32 bits) keeps its order across the wrap. Once a
+// tween is under way the time since its start only counts forward, up to the
+// full range. Other types compare as they are.
+template <class T> struct tweenTime {
+	static bool before(T a, T b) { return a < b; }
+};
+
+template <class T> struct tweenModularTime {
+	static bool before(T a, T b) { return T(a - b) > T(T(~T(0)) >> 1); }
+};
+
+template <> struct tweenTime<unsigned char>      : tweenModularTime<unsigned char>      {};
+template <> struct tweenTime<unsigned short>     : tweenModularTime<unsigned short>     {};
+template <> struct tweenTime<unsigned int>       : tweenModularTime<unsigned int>       {};
+template <> struct tweenTime<unsigned long>      : tweenModularTime<unsigned long>      {};
+template <> struct tweenTime<unsigned long long> : tweenModularTime<unsigned long long> {};
+
+// Converts durations to ticks of Clock. Converting to a coarser clock
+// truncates, e.g. 1500 us is 1 tick of clockMillis
+template <class Clock> struct tweenTicks {
+	static const unsigned long perMsec = Clock::usecPerTick < 1000 ? 1000 / Clock::usecPerTick : 1;
+	static const unsigned long msecPer = Clock::usecPerTick < 1000 ? 1 : Clock::usecPerTick / 1000;
+
+	template <class T> static T fromUsec(T value) { return Clock::usecPerTick == 1 ? value : value / T(Clock::usecPerTick); }
+	template <class T> static T fromMsec(T value) { return perMsec > 1 ? value * T(perMsec) : msecPer > 1 ? value / T(msecPer) : value; }
+};
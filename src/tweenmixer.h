@@ -0,0 +1,161 @@
+/*
+  TweenMixer.h - additive tweens combined per target
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include "tween.h"
+
+// Combines several tweens onto the same outputs. Every target has a base value,
+// either fixed with base() or driven by a tween added with set(). Tweens added
+// with add() are additive layers: each adds how far it has moved from its
+// start (Tween::delta()) on top of the base. seekAll() advances every tween
+// once and calls onUpdate once per target that one of its tweens moved.
+//
+//   typedef TweenMixer<unsigned long, float, 1, 8, Playback> Mixer;   // Features after N are those of its tweens
+//   Mixer            led;
+//   Mixer::TweenType fade, breathe;
+//   fade.from(0).to(200).duringSec(2).start();
+//   breathe.from(0).to(40).duringMsec(800).yoyo().repeat(tweenForever).start();
+//   led.set(0, fade).add(0, breathe).onUpdate(writeLed);
+//   led.update();                                   // in loop()
+//
+// A layer counts from its first new value on, and a stopped tween keeps adding
+// the value it ended at until it is removed. The tweens should not have their
+// own onUpdate callback.
+template <class Tin, class Tout, unsigned int Targets, unsigned int N = 8, class... Features> class TweenMixer
+{
+
+public:
+	typedef Tween<Tin, Tout, easeRuntime, Features...> TweenType;
+	typedef void(*onUpdateCallback)(unsigned int, Tin, Tout);
+
+private:
+	struct layer {
+		TweenType*   tween;
+		unsigned int target;
+		bool         additive;
+		bool         active;                                              // produced a value since it was added
+	};
+
+	layer        layers[N];                                               // set() layers ahead of add() layers
+	unsigned int count;
+	Tout         baseValue[Targets], mixed[Targets];
+	bool         changed[Targets];
+	onUpdateCallback onUpdateCallbackFunction;
+
+	TweenMixer& insert(unsigned int target, TweenType& tween, bool additive) {
+		if (count >= N || target >= Targets) return *this;
+		unsigned int i = count++;
+		while (!additive && i > 0 && layers[i - 1].additive) { layers[i] = layers[i - 1]; i--; }
+		layer added = { &tween, target, additive, false };
+		layers[i] = added;
+		return *this;
+	}
+
+public:
+
+	TweenMixer() {
+		count = 0;
+		for (unsigned int t = 0; t < Targets; t++) {
+			baseValue[t] = Tout(0);
+			mixed[t]     = Tout(0);
+			changed[t]   = false;
+		}
+		onUpdateCallbackFunction = nullptr;
+	}
+
+	// Fixed base value of target, used until a set() tween has produced a value
+	TweenMixer& base(unsigned int target, Tout value) {
+		if (target >= Targets) return *this;
+		baseValue[target] = value;
+		changed[target]   = true;
+		return *this;
+	}
+
+	// tween drives the base value of target
+	TweenMixer& set(unsigned int target, TweenType& tween) {
+		return insert(target, tween, false);
+	}
+
+	// tween adds its change on top of target
+	TweenMixer& add(unsigned int target, TweenType& tween) {
+		return insert(target, tween, true);
+	}
+
+	// Takes every layer of tween out; its targets are reported on the next seekAll()
+	TweenMixer& remove(TweenType& tween) {
+		unsigned int kept = 0;
+		for (unsigned int i = 0; i < count; i++) {
+			if (layers[i].tween == &tween) changed[layers[i].target] = true;
+			else                           layers[kept++] = layers[i];
+		}
+		count = kept;
+		return *this;
+	}
+
+	TweenMixer& onUpdate(onUpdateCallback value) {
+		onUpdateCallbackFunction = value;
+		return *this;
+	}
+
+	// Combined value of target as of the last seekAll()
+	Tout value(unsigned int target) const {
+		return mixed[target];
+	}
+
+	unsigned int size() const {
+		return count;
+	}
+
+	// Seeks every tween to now with seekAt() and combines the layers of each
+	// target in the same pass. Returns the number of targets that changed
+	unsigned int seekAll(Tin now) {
+		Tout sum[Targets];
+		for (unsigned int t = 0; t < Targets; t++) sum[t] = baseValue[t];
+
+		for (unsigned int i = 0; i < count; i++) {
+			layer& l = layers[i];
+			if (l.tween->seekAt(now)) { l.active = true; changed[l.target] = true; }
+			if (!l.active) continue;
+			sum[l.target] = l.additive ? tweenValue<Tout>::add(sum[l.target], l.tween->delta()) : l.tween->value();
+		}
+
+		unsigned int updated = 0;
+		for (unsigned int t = 0; t < Targets; t++) {
+			if (!changed[t]) continue;
+			changed[t] = false;
+			mixed[t]   = sum[t];
+			updated++;
+			if (onUpdateCallbackFunction != nullptr) onUpdateCallbackFunction(t, now, mixed[t]);
+		}
+		return updated;
+	}
+
+	// As seekAll(), with now read once from the clock of the tweens
+	unsigned int update() {
+		return seekAll(Tin(TweenType::clockType::now()));
+	}
+
+};
@@ -0,0 +1,221 @@
+/*
+  TweenPool.h - batch update of many tween channels
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include "tween.h"
+
+// Fixed-capacity set of N tween channels, stored as one array per field.
+// Channels are grouped by easing type, so updateAll() selects each curve once
+// and runs a tight loop over all channels that use it.
+//
+//   TweenPool<unsigned long, float, 512> pool;
+//   pool.add().from(0).to(255).during(1000).easing(QuadEaseIn).start(millis());
+//   pool.updateAll(millis());
+//
+// Unlike Tween, a channel that passes its end snaps to the end value and
+// fires its callback once before stopping, as ticks rarely land on the end.
+// Positions are clock times and compare across the wrap of an unsigned Tin
+// (tweenTime), so a start may lie up to half its range ahead.
+template <class Tin, class Tout, unsigned int N> class TweenPool
+{
+
+public:
+	typedef void(*onUpdateCallback)(unsigned int, Tin, Tout);
+
+	class Channel
+	{
+	public:
+		Channel(TweenPool& pool, unsigned int index) : pool(pool), index(index) {}
+
+		Tout value() const         { return pool.prevValue[index]; }
+		unsigned int channel() const { return index; }
+		bool valid() const         { return index < pool.count; }
+
+		Channel& from(Tout value)   { pool.startValue[index] = value; return *this; }
+		Channel& to(Tout value)     { pool.endValue[index]   = value; return *this; }
+		Channel& during(Tin value)  { pool.duration[index]   = value; return *this; }
+
+		Channel& easing(easingType value) {
+			if (pool.easeMode[index] != value) {
+				pool.easeMode[index] = value;
+				pool.ordered         = false;
+			}
+			return *this;
+		}
+
+		Channel& startAt(Tin value) {
+			pool.startPos[index]  = value;
+			pool.prevValue[index] = pool.startValue[index];
+			pool.runState[index]  = started;
+			return *this;
+		}
+
+		Channel& start(Tin now)    { return startAt(now); }
+		Channel& stop()            { pool.runState[index] = stopped; return *this; }
+		bool isAnimating() const   { return pool.runState[index] != stopped; }
+
+	private:
+		TweenPool&   pool;
+		unsigned int index;
+	};
+
+private:
+	enum state {
+		started,
+		running,
+		stopped,
+	};
+
+	Tout          startValue[N + 1], endValue[N + 1], prevValue[N + 1];      // channel N is the spare one add() returns when full
+	Tin           startPos[N + 1], duration[N + 1];
+	unsigned char easeMode[N + 1];
+	unsigned char runState[N + 1];
+	unsigned int  order[N];                                                 // channel indices, sorted by easeMode
+	unsigned int  count;
+	bool          ordered;
+	onUpdateCallback onUpdateCallbackFunction;
+
+	// Counting sort of the channels on easeMode, only redone after easing() changed a curve
+	void sortByEasing() {
+		unsigned int offsets[easingTypeCount + 1] = { 0 };
+		for (unsigned int i = 0; i < count; i++) offsets[easeMode[i] + 1]++;
+		for (unsigned int m = 1; m < easingTypeCount + 1; m++) offsets[m] += offsets[m - 1];
+		for (unsigned int i = 0; i < count; i++) order[offsets[easeMode[i]]++] = i;
+		ordered = true;
+	}
+
+	template <class Curve> void advance(unsigned int first, unsigned int last, Tin now) {
+		for (unsigned int k = first; k < last; k++) {
+			unsigned int i = order[k];
+			if (runState[i] == stopped || (runState[i] == started && tweenTime<Tin>::before(now, startPos[i]))) continue;
+
+			Tin elapsed = now - startPos[i];
+			if (elapsed >= duration[i]) {
+				prevValue[i] = endValue[i];
+				runState[i]  = stopped;
+			} else {
+				prevValue[i] = Curve::template calc<Tin,Tout>(Curve::mode, elapsed, startValue[i], endValue[i] - startValue[i], duration[i]);
+				runState[i]  = running;                                     // past the start, elapsed only counts forward now
+			}
+			if (onUpdateCallbackFunction != nullptr) onUpdateCallbackFunction(i, now, prevValue[i]);
+		}
+	}
+
+public:
+
+	TweenPool() {
+		count                    = 0;
+		ordered                  = true;
+		onUpdateCallbackFunction = nullptr;
+	}
+
+	// Claims the next free channel, initialised as a stopped linear 0..1 tween.
+	// When the pool is full it returns a spare channel that is never updated and
+	// whose valid() is false, so a pool that may fill up must check it
+	Channel add() {
+		unsigned int i = count < N ? count++ : N;
+		startValue[i] = 0;
+		endValue[i]   = 1;
+		prevValue[i]  = 0;
+		startPos[i]   = 0;
+		duration[i]   = 1;
+		easeMode[i]   = LinearEaseIn;
+		runState[i]   = stopped;
+		ordered       = false;
+		return Channel(*this, i);
+	}
+
+	Channel operator[](unsigned int index) {
+		return Channel(*this, index);
+	}
+
+	unsigned int size() const {
+		return count;
+	}
+
+	// Sends every channel under way at now to targets[channel] without a jump,
+	// as Tween::retarget() does; the other channels just get the new end value.
+	// targets holds size() values, the spare channel N is left alone
+	void retargetAll(Tin now, const Tout* targets, retargetMode mode = RetargetPosition) {
+		for (unsigned int i = 0; i < count; i++) {
+			Tin elapsed = now - startPos[i];
+			if (runState[i] == stopped || (runState[i] == started && tweenTime<Tin>::before(now, startPos[i])) || !(elapsed < duration[i])) { endValue[i] = targets[i]; continue; }
+
+			easingType curve   = easingType(easeMode[i]);
+			Tin        left    = duration[i] - elapsed;
+			Tout       current = easeRuntime::calc<Tin,Tout>(curve, elapsed, startValue[i], endValue[i] - startValue[i], duration[i]);
+			float      speed   = mode != RetargetVelocity ? 0 : tweenRetarget<easeRuntime,Tin,Tout>::speed(curve, startValue[i], endValue[i], current, targets[i], float(elapsed) / float(duration[i]), 1, left, duration[i]);
+			tweenRetarget<easeRuntime,Tin,Tout> rest(curve, mode, now, elapsed, left, current, targets[i], speed);
+
+			startPos[i]   = rest.startPos;
+			duration[i]   = rest.duration;
+			startValue[i] = rest.startValue;
+			endValue[i]   = targets[i];
+			runState[i]   = running;                                        // rest.startPos lies in the past, not a start to wait for
+		}
+	}
+
+	TweenPool& onUpdate(onUpdateCallback value) {
+		onUpdateCallbackFunction = value;
+		return *this;
+	}
+
+	// Advances every running channel to now; one curve dispatch per easing group
+	void updateAll(Tin now) {
+		if (!ordered) sortByEasing();
+
+		unsigned int first = 0;
+		while (first < count) {
+			unsigned char mode = easeMode[order[first]];
+			unsigned int  last = first + 1;
+			while (last < count && easeMode[order[last]] == mode) last++;
+
+			switch (mode) {
+				#define PoolCurves(EASEMETHOD) \
+				case EASEMETHOD ## EaseIn:    advance<easeCurve<EASEMETHOD ## EaseIn>    >(first, last, now); break; \
+				case EASEMETHOD ## EaseOut:   advance<easeCurve<EASEMETHOD ## EaseOut>   >(first, last, now); break; \
+				case EASEMETHOD ## EaseInOut: advance<easeCurve<EASEMETHOD ## EaseInOut> >(first, last, now); break;
+				PoolCurves(Linear)
+				PoolCurves(Back)
+				PoolCurves(Bounce)
+				PoolCurves(Circ)
+				PoolCurves(Cubic)
+				PoolCurves(Elastic)
+				PoolCurves(Expo)
+				PoolCurves(Quad)
+				PoolCurves(Quart)
+				PoolCurves(Quint)
+				PoolCurves(Sine)
+				#undef PoolCurves
+				case ElasticEaseInFast:    advance<easeCurve<ElasticEaseInFast>    >(first, last, now); break;
+				case ElasticEaseOutFast:   advance<easeCurve<ElasticEaseOutFast>   >(first, last, now); break;
+				case ElasticEaseInOutFast: advance<easeCurve<ElasticEaseInOutFast> >(first, last, now); break;
+			}
+			first = last;
+		}
+	}
+
+};
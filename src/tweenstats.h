@@ -0,0 +1,304 @@
+/*
+  TweenStats.h - optional instrumentation of Tween::seek()
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "ease.h"
+
+// Counters for Tween::seek() and calcValue(), compiled in only when
+// TWEEN_INSTRUMENT is defined before tween.h is included; otherwise the hooks
+// expand to nothing. Counts are aggregated over all tweens in
+// tweenStats::global(); TWEEN_INSTRUMENT_INSTANCE also keeps the scalar counts
+// per tween, see Tween::counts().
+//
+//   #define TWEEN_INSTRUMENT
+//   #include <tween.h>
+//   ...
+//   tweenStats::global().dump(Serial);
+//
+// Curve evaluations are timed with tweenCycles(): the time stamp counter on
+// x86, micros() on other Arduino targets and nanoseconds elsewhere. Define
+// TWEEN_CYCLES as an expression to use another counter, e.g. DWT->CYCCNT.
+// The cycle totals are 64 bit except on AVR, where micros() takes over an
+// hour of curve time to wrap 32 bits.
+//
+// The counters are plain integers, not atomics: instrument tweens that are
+// updated from one thread at a time.
+//
+// On the host, TWEEN_TRACE additionally records every curve evaluation in a
+// ring buffer that tweenTrace::write() exports as Chrome trace JSON, to be
+// opened in chrome://tracing or ui.perfetto.dev; slices are named after the
+// easing, so hot curves stand out.
+#if defined(TWEEN_TRACE) && !defined(TWEEN_INSTRUMENT)
+#define TWEEN_INSTRUMENT
+#endif
+#if defined(TWEEN_INSTRUMENT_INSTANCE) && !defined(TWEEN_INSTRUMENT)
+#define TWEEN_INSTRUMENT
+#endif
+
+#if defined(TWEEN_INSTRUMENT)
+
+#if !defined(TWEEN_CYCLES) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif !defined(TWEEN_CYCLES) && !defined(ARDUINO)
+#include <chrono>
+#endif
+#if !defined(ARDUINO)
+#include <stdio.h>
+#endif
+
+#if defined(__AVR__)
+typedef uint32_t tweenCycleTotal;
+#else
+typedef uint64_t tweenCycleTotal;
+#endif
+
+inline uint32_t tweenCycles() {
+#if defined(TWEEN_CYCLES)
+	return uint32_t(TWEEN_CYCLES);
+#elif defined(__x86_64__) || defined(__i386__)
+	return uint32_t(__rdtsc());
+#elif defined(ARDUINO)
+	return uint32_t(micros());
+#else
+	return uint32_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Why seek() returned without a new value
+enum tweenRejection {
+	RejectStopped,
+	RejectBeforeStart,
+	RejectPastEnd,
+	RejectStep,
+	RejectIncrement,
+};
+const unsigned char tweenRejectionCount = RejectIncrement + 1;
+
+struct tweenCounts {
+	uint32_t seeks;                                                          // seek() calls, including update()
+	uint32_t updates;                                                        // seeks that produced a new value
+	uint32_t callbacks;                                                      // onUpdate invocations
+	uint32_t evaluations;                                                    // exact curve evaluations
+	uint32_t forwardSteps;                                                   // incremental evaluations
+	uint32_t rejected[tweenRejectionCount];
+
+	void reset() {
+		memset(this, 0, sizeof(*this));
+	}
+};
+
+#if defined(ARDUINO)
+typedef const __FlashStringHelper* tweenName;
+#define TweenName(s) F(s)
+#else
+typedef const char* tweenName;
+#define TweenName(s) s
+#endif
+
+inline tweenName easingName(easingType easeMode) {
+	switch (easeMode) {
+		#define StatsNames(EASEMETHOD) \
+		case EASEMETHOD ## EaseIn:    return TweenName(#EASEMETHOD "EaseIn"); \
+		case EASEMETHOD ## EaseOut:   return TweenName(#EASEMETHOD "EaseOut"); \
+		case EASEMETHOD ## EaseInOut: return TweenName(#EASEMETHOD "EaseInOut");
+		StatsNames(Linear)
+		StatsNames(Back)
+		StatsNames(Bounce)
+		StatsNames(Circ)
+		StatsNames(Cubic)
+		StatsNames(Elastic)
+		StatsNames(Expo)
+		StatsNames(Quad)
+		StatsNames(Quart)
+		StatsNames(Quint)
+		StatsNames(Sine)
+		#undef StatsNames
+		case ElasticEaseInFast:    return TweenName("ElasticEaseInFast");
+		case ElasticEaseOutFast:   return TweenName("ElasticEaseOutFast");
+		case ElasticEaseInOutFast: return TweenName("ElasticEaseInOutFast");
+	}
+	return TweenName("?");
+}
+
+inline tweenName rejectionName(unsigned char reason) {
+	switch (reason) {
+		case RejectStopped:     return TweenName("stopped");
+		case RejectBeforeStart: return TweenName("before_start");
+		case RejectPastEnd:     return TweenName("past_end");
+		case RejectStep:        return TweenName("step_filter");
+		case RejectIncrement:   return TweenName("increment_filter");
+	}
+	return TweenName("?");
+}
+
+#if defined(TWEEN_TRACE) && !defined(ARDUINO)
+// Ring buffer of the last Capacity curve evaluations
+class tweenTrace
+{
+public:
+	static const unsigned int capacity = 1u << 16;
+
+	struct Event {
+		uint64_t      start;                                                 // ns since the first event
+		uint32_t      duration;                                              // ns
+		unsigned char easeMode;
+	};
+
+	static tweenTrace& global() {
+		static tweenTrace trace;
+		return trace;
+	}
+
+	static uint64_t now() {
+		return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	void record(easingType easeMode, uint64_t start, uint64_t end) {
+		if (origin == 0) origin = start;
+		Event& event   = events[recorded++ % capacity];
+		event.start    = start - origin;
+		event.duration = uint32_t(end - start);
+		event.easeMode = (unsigned char)easeMode;
+	}
+
+	void reset() {
+		recorded = 0;
+		origin   = 0;
+	}
+
+	// Writes the recorded evaluations as Chrome trace JSON, one complete ("X")
+	// event per evaluation named after its easing
+	void write(FILE* out) const;
+
+private:
+	Event    events[capacity];
+	uint64_t recorded, origin;
+
+	tweenTrace() : recorded(0), origin(0) {}
+};
+#endif
+
+struct tweenStats {
+	tweenCounts     counts;
+	uint32_t        curveCalls[easingTypeCount];
+	tweenCycleTotal curveCycles[easingTypeCount];
+
+	static tweenStats& global() {
+		static tweenStats stats;
+		return stats;
+	}
+
+	void reset() {
+		memset(this, 0, sizeof(*this));
+	}
+
+	void curve(easingType easeMode, uint32_t cycles) {
+		curveCalls[easeMode]++;
+		curveCycles[easeMode] += cycles;
+	}
+
+	// Prints the counters as one JSON object per line: the totals, then one line
+	// per easing that was evaluated, with its calls and average cycles
+#if defined(ARDUINO)
+	void dump(Print& out) const {
+		out.print(F("{\"seeks\":"));        out.print(counts.seeks);
+		out.print(F(",\"updates\":"));      out.print(counts.updates);
+		out.print(F(",\"callbacks\":"));    out.print(counts.callbacks);
+		out.print(F(",\"evaluations\":"));  out.print(counts.evaluations);
+		out.print(F(",\"forward_steps\":")); out.print(counts.forwardSteps);
+		for (unsigned char r = 0; r < tweenRejectionCount; r++) {
+			out.print(F(",\"")); out.print(rejectionName(r)); out.print(F("\":")); out.print(counts.rejected[r]);
+		}
+		out.println('}');
+		for (unsigned char m = 0; m < easingTypeCount; m++) {
+			if (curveCalls[m] == 0) continue;
+			out.print(F("{\"easing\":\""));      out.print(easingName(easingType(m)));
+			out.print(F("\",\"calls\":"));       out.print(curveCalls[m]);
+			out.print(F(",\"cycles_per_call\":")); out.print(float(curveCycles[m]) / curveCalls[m], 1);
+			out.println('}');
+		}
+	}
+#else
+	void dump(FILE* out) const {
+		fprintf(out, "{\"seeks\":%lu,\"updates\":%lu,\"callbacks\":%lu,\"evaluations\":%lu,\"forward_steps\":%lu",
+		        (unsigned long)counts.seeks, (unsigned long)counts.updates, (unsigned long)counts.callbacks,
+		        (unsigned long)counts.evaluations, (unsigned long)counts.forwardSteps);
+		for (unsigned char r = 0; r < tweenRejectionCount; r++) fprintf(out, ",\"%s\":%lu", rejectionName(r), (unsigned long)counts.rejected[r]);
+		fprintf(out, "}\n");
+		for (unsigned char m = 0; m < easingTypeCount; m++) {
+			if (curveCalls[m] == 0) continue;
+			fprintf(out, "{\"easing\":\"%s\",\"calls\":%lu,\"cycles_per_call\":%.1f}\n",
+			        easingName(easingType(m)), (unsigned long)curveCalls[m], double(curveCycles[m]) / curveCalls[m]);
+		}
+	}
+#endif
+};
+
+#if defined(TWEEN_TRACE) && !defined(ARDUINO)
+inline void tweenTrace::write(FILE* out) const {
+	const tweenCounts& counts = tweenStats::global().counts;
+	uint64_t first = recorded > capacity ? recorded - capacity : 0;
+	uint64_t end   = 0;
+	fprintf(out, "{\"traceEvents\":[\n");
+	for (uint64_t i = first; i < recorded; i++) {
+		const Event& event = events[i % capacity];
+		fprintf(out, "{\"name\":\"%s\",\"cat\":\"tween\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f},\n",
+		        easingName(easingType(event.easeMode)), event.start / 1000.0, event.duration / 1000.0);
+		end = event.start + event.duration;
+	}
+	fprintf(out, "{\"name\":\"seek\",\"cat\":\"tween\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"updates\":%lu",
+	        end / 1000.0, (unsigned long)counts.updates);
+	for (unsigned char r = 0; r < tweenRejectionCount; r++) fprintf(out, ",\"%s\":%lu", rejectionName(r), (unsigned long)counts.rejected[r]);
+	fprintf(out, "}}\n]}\n");
+}
+
+#define TWEEN_TRACE_BEGIN()         uint64_t tweenTraceStart = tweenTrace::now()
+#define TWEEN_TRACE_END(easeMode)   tweenTrace::global().record(easeMode, tweenTraceStart, tweenTrace::now())
+#else
+#define TWEEN_TRACE_BEGIN()
+#define TWEEN_TRACE_END(easeMode)
+#endif
+
+#if defined(TWEEN_INSTRUMENT_INSTANCE)
+#define TWEEN_COUNT(field)          (tweenStats::global().counts.field++, instanceCounts.field++)
+#define TWEEN_REJECT(reason)        (tweenStats::global().counts.rejected[reason]++, instanceCounts.rejected[reason]++)
+#else
+#define TWEEN_COUNT(field)          (tweenStats::global().counts.field++)
+#define TWEEN_REJECT(reason)        (tweenStats::global().counts.rejected[reason]++)
+#endif
+#define TWEEN_CURVE_BEGIN()         TWEEN_TRACE_BEGIN(); uint32_t tweenCurveStart = tweenCycles()
+#define TWEEN_CURVE_END(easeMode)   tweenStats::global().curve(easeMode, tweenCycles() - tweenCurveStart); TWEEN_TRACE_END(easeMode)
+
+#else
+
+#define TWEEN_COUNT(field)
+#define TWEEN_REJECT(reason)
+#define TWEEN_CURVE_BEGIN()
+#define TWEEN_CURVE_END(easeMode)
+
+#endif
@@ -0,0 +1,327 @@
+/*
+  TweenWorld.h - multi-threaded tween updates for host builds
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+// Needs std::thread and std::atomic, so it is only available off-target
+// (Linux, macOS, Windows hosts); on Arduino use TweenPool instead.
+#if !defined(ARDUINO)
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ease.h"
+#include "tweenclock.h"
+
+// Tween channels updated by a pool of worker threads. Channels are split into
+// chunks; every thread works through its own share of chunks and then steals
+// chunks from the threads that are still busy.
+//
+//   TweenWorld<double, float> world(50000, 4);
+//   world.add().from(0).to(1).during(2.0).easing(SineEaseInOut).start(0);
+//   world.advance(now);                // from the simulation thread
+//   float v = world.value(i);          // from any thread, never blocks advance()
+//
+// advance() writes the new values into the back half of a double buffer and
+// then publishes it, together with the number of channels it holds. Each half
+// carries a sequence number (seqlock), so a reader that was overtaken by two
+// frames retries instead of returning torn data. add() only touches the back
+// half, so a channel shows up for readers with the first frame after it.
+// onUpdate callbacks are queued per thread and run on the thread that called
+// advance(), after all workers have finished. Between frames the workers sleep
+// on a condition variable, so an idle world takes no CPU time.
+//
+// Channels must be configured (add, from, to, start, ...) from the thread that
+// calls advance(), between advance() calls.
+template <class Tin, class Tout> class TweenWorld
+{
+
+public:
+	typedef void(*onUpdateCallback)(unsigned int, Tin, Tout);
+
+	class Channel
+	{
+	public:
+		Channel(TweenWorld& world, unsigned int index) : world(world), index(index) {}
+
+		Tout value() const           { return world.value(index); }
+		unsigned int channel() const { return index; }
+		bool valid() const           { return index < world.count; }
+
+		Channel& from(Tout value)          { world.startValue[index] = value; return *this; }
+		Channel& to(Tout value)            { world.endValue[index]   = value; return *this; }
+		Channel& during(Tin value)         { world.duration[index]   = value; return *this; }
+		Channel& easing(easingType value)  { world.easeMode[index]   = value; return *this; }
+
+		Channel& startAt(Tin value) {
+			world.startPos[index] = value;
+			world.runState[index] = started;
+			return *this;
+		}
+
+		Channel& start(Tin now)    { return startAt(now); }
+		Channel& stop()            { world.runState[index] = stopped; return *this; }
+		bool isAnimating() const   { return world.runState[index] != stopped; }
+
+	private:
+		TweenWorld&  world;
+		unsigned int index;
+	};
+
+private:
+	enum state {
+		started,
+		running,
+		stopped,
+	};
+
+	struct Update {
+		unsigned int channel;
+		Tout         value;
+	};
+
+	// Per-thread work queue and callback batch, padded so that threads do not
+	// share cache lines
+	struct Worker {
+		std::atomic<unsigned int> next;                                     // next chunk to claim
+		unsigned int              end;                                      // one past the last chunk
+		std::vector<Update>       updates;
+		char                      padding[64];
+	};
+
+	struct Snapshot {
+		std::atomic<unsigned int> sequence;                                 // odd while being written
+		std::atomic<unsigned int> count;                                    // channels in this frame
+		std::vector<Tout>         value;
+	};
+
+	static const unsigned int chunkSize = 256;
+
+	std::vector<Tout>          startValue, endValue;
+	std::vector<Tin>           startPos, duration;
+	std::vector<unsigned char> easeMode, runState;
+	unsigned int               count, capacity;
+
+	Snapshot                   snapshot[2];
+	std::atomic<unsigned int>  front;
+
+	std::vector<Worker>        workers;
+	std::vector<std::thread>   threads;
+	std::mutex                 lock;                                        // guards frame, finished and quit
+	std::condition_variable    wake, done;
+	unsigned int               frame, finished;
+	bool                       quit;
+	Tin                        frameTime;
+	onUpdateCallback           onUpdateCallbackFunction;
+
+	// Channels that do not move carry their previous value over into the new frame
+	void advanceRange(unsigned int first, unsigned int last, const Tout* prev, Tout* out, Worker& worker) {
+		Tin now = frameTime;
+		for (unsigned int i = first; i < last; i++) {
+			if (runState[i] == stopped || (runState[i] == started && tweenTime<Tin>::before(now, startPos[i]))) { out[i] = prev[i]; continue; }
+
+			Tin elapsed = now - startPos[i];
+			if (elapsed >= duration[i]) {
+				out[i]      = endValue[i];
+				runState[i] = stopped;
+			} else {
+				out[i] = easeRuntime::calc<Tin,Tout>(easingType(easeMode[i]), elapsed, startValue[i], endValue[i] - startValue[i], duration[i]);
+				runState[i] = running;                                      // past the start, elapsed only counts forward now
+			}
+			if (onUpdateCallbackFunction != nullptr) worker.updates.push_back(Update{ i, out[i] });
+		}
+	}
+
+	// Runs the chunks of worker self, then steals from the others
+	void work(unsigned int self) {
+		unsigned int back = front.load(std::memory_order_relaxed) ^ 1;
+		const Tout*  prev = snapshot[back ^ 1].value.data();
+		Tout*        out  = snapshot[back].value.data();
+		Worker&      mine = workers[self];
+		mine.updates.clear();
+		for (unsigned int k = 0; k < workers.size(); k++) {
+			Worker& victim = workers[(self + k) % workers.size()];
+			for (;;) {
+				unsigned int chunk = victim.next.fetch_add(1, std::memory_order_relaxed);
+				if (chunk >= victim.end) break;
+				unsigned int first = chunk * chunkSize;
+				unsigned int last  = first + chunkSize < count ? first + chunkSize : count;
+				advanceRange(first, last, prev, out, mine);
+			}
+		}
+	}
+
+	static unsigned int coreCount() {
+		unsigned int cores = std::thread::hardware_concurrency();
+		return cores != 0 ? cores : 1;
+	}
+
+	void workerLoop(unsigned int self) {
+		unsigned int seen = 0;
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				wake.wait(guard, [&] { return frame != seen || quit; });
+				if (quit) return;
+				seen = frame;
+			}
+			work(self);
+			std::lock_guard<std::mutex> guard(lock);
+			if (++finished == threads.size()) done.notify_one();
+		}
+	}
+
+public:
+
+	// capacity channels, updated by threadCount threads including the caller of
+	// advance(); 0 uses one thread per core
+	TweenWorld(unsigned int capacity, unsigned int threadCount = 0)
+		: startValue(capacity + 1), endValue(capacity + 1), startPos(capacity + 1), duration(capacity + 1),   // and the spare channel
+		  easeMode(capacity + 1), runState(capacity + 1), count(0), capacity(capacity), front(0),
+		  workers(threadCount != 0 ? threadCount : coreCount()),
+		  frame(0), finished(0), quit(false), frameTime(0), onUpdateCallbackFunction(nullptr)
+	{
+		for (unsigned int b = 0; b < 2; b++) {
+			snapshot[b].sequence.store(0);
+			snapshot[b].count.store(0);
+			snapshot[b].value.assign(capacity + 1, Tout(0));
+		}
+		for (unsigned int t = 1; t < workers.size(); t++) threads.push_back(std::thread(&TweenWorld::workerLoop, this, t));
+	}
+
+	~TweenWorld() {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			quit = true;
+		}
+		wake.notify_all();
+		for (unsigned int t = 0; t < threads.size(); t++) threads[t].join();
+	}
+
+	TweenWorld(const TweenWorld&)            = delete;
+	TweenWorld& operator=(const TweenWorld&) = delete;
+
+	// Claims the next free channel, initialised as a stopped linear 0..1 tween.
+	// When the world is full it returns a spare channel that is never advanced
+	// and whose valid() is false, so a world that may fill up must check it
+	Channel add() {
+		unsigned int i = count < capacity ? count++ : capacity;
+		startValue[i] = 0;
+		endValue[i]   = 1;
+		startPos[i]   = 0;
+		duration[i]   = 1;
+		easeMode[i]   = LinearEaseIn;
+		runState[i]   = stopped;
+		snapshot[front.load(std::memory_order_relaxed) ^ 1].value[i] = 0;    // back half; readers see the front one
+		return Channel(*this, i);
+	}
+
+	Channel operator[](unsigned int index) {
+		return Channel(*this, index);
+	}
+
+	unsigned int size() const {
+		return count;
+	}
+
+	unsigned int threadCount() const {
+		return (unsigned int)workers.size();
+	}
+
+	TweenWorld& onUpdate(onUpdateCallback value) {
+		onUpdateCallbackFunction = value;
+		return *this;
+	}
+
+	// Advances every running channel to now on all threads, publishes the new
+	// values and then runs the queued callbacks, thread by thread
+	void advance(Tin now) {
+		unsigned int chunks = (count + chunkSize - 1) / chunkSize;
+		unsigned int share  = (chunks + workers.size() - 1) / workers.size();
+		for (unsigned int t = 0; t < workers.size(); t++) {
+			unsigned int first = t * share < chunks ? t * share : chunks;
+			workers[t].next.store(first, std::memory_order_relaxed);
+			workers[t].end = first + share < chunks ? first + share : chunks;
+		}
+
+		unsigned int back = front.load(std::memory_order_relaxed) ^ 1;
+		Snapshot&    out  = snapshot[back];
+		out.sequence.fetch_add(1, std::memory_order_relaxed);                   // odd: readers of this half retry
+		std::atomic_thread_fence(std::memory_order_release);
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			frameTime = now;
+			finished  = 0;
+			frame++;
+		}
+		wake.notify_all();
+		work(0);
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			done.wait(guard, [&] { return finished == threads.size(); });
+		}
+
+		out.count.store(count, std::memory_order_relaxed);
+		out.sequence.fetch_add(1, std::memory_order_release);                   // even again
+		front.store(back, std::memory_order_release);
+
+		if (onUpdateCallbackFunction == nullptr) return;
+		for (unsigned int t = 0; t < workers.size(); t++) {
+			const std::vector<Update>& updates = workers[t].updates;
+			for (unsigned int u = 0; u < updates.size(); u++) onUpdateCallbackFunction(updates[u].channel, now, updates[u].value);
+		}
+	}
+
+	// Last published value of a channel; safe to call from any thread
+	Tout value(unsigned int index) const {
+		for (;;) {
+			const Snapshot& in = snapshot[front.load(std::memory_order_acquire)];
+			unsigned int before = in.sequence.load(std::memory_order_acquire);
+			Tout result = in.value[index];
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if ((before & 1) == 0 && in.sequence.load(std::memory_order_relaxed) == before) return result;
+		}
+	}
+
+	// Copies the values of all channels from one published frame into out,
+	// which must hold size() values, and returns how many channels that frame
+	// had. Channels added since then are left out. Safe to call from any thread
+	unsigned int read(Tout* out) const {
+		for (;;) {
+			const Snapshot& in = snapshot[front.load(std::memory_order_acquire)];
+			unsigned int before = in.sequence.load(std::memory_order_acquire);
+			unsigned int n      = in.count.load(std::memory_order_relaxed);
+			for (unsigned int i = 0; i < n; i++) out[i] = in.value[i];
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if ((before & 1) == 0 && in.sequence.load(std::memory_order_relaxed) == before) return n;
+		}
+	}
+
+};
+
+#endif
@@ -0,0 +1,177 @@
+/*
+  Vec.h - multi-lane values (colours, positions, rotations) for tweens
+  Copyright (c) 2019, 2020 Thijs Elenbaas.  All right reserved.
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the "Software"), to deal in the Software without restriction,
+  including without limitation the rights to use, copy, modify, merge,
+  publish, distribute, sublicense, and/or sell copies of the Software,
+  and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+   TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+   PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+   SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+   ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+   OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include <math.h>
+#include "tween.h"
+
+// Fixed-size vector of N lanes, e.g. Vec<float,3> for a position or
+// Vec<unsigned char,4> for a packed RGBW colour. A Tween over a Vec evaluates
+// the easing factor once per seek() and applies it to all lanes in one loop,
+// with a single onUpdate callback for the whole vector:
+//
+//   Tween<unsigned long, Vec<unsigned char,4> > pixel;
+//   pixel.from(Vec<unsigned char,4>(0)).to(warmWhite).duringMsec(500).easing(SineEaseInOut);
+//
+// increment() takes a Vec of per-lane limits; the tween updates when any lane
+// moved at least its limit.
+template <class T, unsigned int N> struct Vec
+{
+	T lane[N];
+
+	Vec() {}
+
+	Vec(T value) {
+		for (unsigned int i = 0; i < N; i++) lane[i] = value;
+	}
+
+	Vec(const T (&values)[N]) {
+		for (unsigned int i = 0; i < N; i++) lane[i] = values[i];
+	}
+
+	T&       operator[](unsigned int i)       { return lane[i]; }
+	const T& operator[](unsigned int i) const { return lane[i]; }
+
+	bool operator==(const Vec& other) const {
+		for (unsigned int i = 0; i < N; i++) if (lane[i] != other.lane[i]) return false;
+		return true;
+	}
+	bool operator!=(const Vec& other) const { return !(*this == other); }
+};
+
+// Unit quaternion for rotations; tweens between two orientations with slerp
+struct Quat
+{
+	float w, x, y, z;
+
+	Quat(float w = 1, float x = 0, float y = 0, float z = 0) : w(w), x(x), y(y), z(z) {}
+
+	bool operator==(const Quat& o) const { return w == o.w && x == o.x && y == o.y && z == o.z; }
+	bool operator!=(const Quat& o) const { return !(*this == o); }
+};
+
+template <class T, unsigned int N> struct tweenValue< Vec<T,N> > {
+	template <class Curve, class Tin> static Vec<T,N> calc(easingType easeMode, Tin t, const Vec<T,N>& from, const Vec<T,N>& to, Tin d) {
+		return mix(from, to, Curve::template calc<Tin,float>(easeMode, t, 0.0f, 1.0f, d));
+	}
+
+	static Vec<T,N> mix(const Vec<T,N>& from, const Vec<T,N>& to, float f) {
+		Vec<T,N> result;
+		for (unsigned int i = 0; i < N; i++) result.lane[i] = T((float(to.lane[i]) - float(from.lane[i])) * f + float(from.lane[i]));
+		return result;
+	}
+
+	static bool within(const Vec<T,N>& a, const Vec<T,N>& b, const Vec<T,N>& limit) {
+		for (unsigned int i = 0; i < N; i++) {
+			float delta = float(a.lane[i]) - float(b.lane[i]);
+			if (delta * delta >= float(limit.lane[i]) * float(limit.lane[i])) return false;
+		}
+		return true;
+	}
+
+	static Vec<T,N> difference(const Vec<T,N>& a, const Vec<T,N>& b) {
+		Vec<T,N> result;
+		for (unsigned int i = 0; i < N; i++) result.lane[i] = T(a.lane[i] - b.lane[i]);
+		return result;
+	}
+
+	static Vec<T,N> add(const Vec<T,N>& a, const Vec<T,N>& delta) {
+		Vec<T,N> result;
+		for (unsigned int i = 0; i < N; i++) result.lane[i] = T(a.lane[i] + delta.lane[i]);
+		return result;
+	}
+
+	// Change A projected onto change B, in units of B
+	static float ratio(const Vec<T,N>& fromA, const Vec<T,N>& toA, const Vec<T,N>& fromB, const Vec<T,N>& toB) {
+		float along = 0, length = 0;
+		for (unsigned int i = 0; i < N; i++) {
+			float a = float(toA.lane[i]) - float(fromA.lane[i]), b = float(toB.lane[i]) - float(fromB.lane[i]);
+			along  += a * b;
+			length += b * b;
+		}
+		return length == 0 ? 0 : along / length;
+	}
+};
+
+// Overshooting curves (back, elastic) extrapolate along the same great circle.
+// For increment(), limit.w is the minimum rotation angle in radians. Additive
+// rotations compose: difference() is the rotation from b to a, add() applies
+// delta after a.
+template <> struct tweenValue<Quat> {
+	template <class Curve, class Tin> static Quat calc(easingType easeMode, Tin t, const Quat& from, const Quat& to, Tin d) {
+		return mix(from, to, Curve::template calc<Tin,float>(easeMode, t, 0.0f, 1.0f, d));
+	}
+
+	static Quat mix(const Quat& from, Quat to, float f) {
+		float cosAngle = from.w*to.w + from.x*to.x + from.y*to.y + from.z*to.z;
+		if (cosAngle < 0) {                                                 // take the short way round
+			cosAngle = -cosAngle;
+			to       = Quat(-to.w, -to.x, -to.y, -to.z);
+		}
+		float a, b;
+		if (cosAngle > 0.9995f) {                                           // nearly parallel: lerp, then normalize
+			a = 1 - f;
+			b = f;
+		} else {
+			float angle = acos(cosAngle);
+			float s     = 1 / sin(angle);
+			a = sin((1 - f) * angle) * s;
+			b = sin(f * angle) * s;
+		}
+		Quat  q(a*from.w + b*to.w, a*from.x + b*to.x, a*from.y + b*to.y, a*from.z + b*to.z);
+		float n = 1 / sqrt(q.w*q.w + q.x*q.x + q.y*q.y + q.z*q.z);
+		return Quat(q.w*n, q.x*n, q.y*n, q.z*n);
+	}
+
+	static bool within(const Quat& a, const Quat& b, const Quat& limit) {
+		float cosAngle = fabs(a.w*b.w + a.x*b.x + a.y*b.y + a.z*b.z);
+		return 2 * acos(cosAngle > 1 ? 1.0f : cosAngle) < limit.w;
+	}
+
+	static Quat difference(const Quat& a, const Quat& b) {
+		return product(Quat(b.w, -b.x, -b.y, -b.z), a);
+	}
+
+	static Quat add(const Quat& a, const Quat& delta) {
+		return product(a, delta);
+	}
+
+	// Angle of rotation A in units of rotation B, negative when their axes point apart
+	static float ratio(const Quat& fromA, const Quat& toA, const Quat& fromB, const Quat& toB) {
+		Quat  a = difference(toA, fromA), b = difference(toB, fromB);
+		float angleA = 2 * acos(fabs(a.w) > 1 ? 1.0f : fabs(a.w)), angleB = 2 * acos(fabs(b.w) > 1 ? 1.0f : fabs(b.w));
+		float axes   = (a.x*b.x + a.y*b.y + a.z*b.z) * (a.w < 0 ? -1 : 1) * (b.w < 0 ? -1 : 1);
+		if (angleB == 0) return 0;
+		return axes < 0 ? -angleA / angleB : angleA / angleB;
+	}
+
+	static Quat product(const Quat& p, const Quat& q) {
+		return Quat(p.w*q.w - p.x*q.x - p.y*q.y - p.z*q.z,
+		            p.w*q.x + p.x*q.w + p.y*q.z - p.z*q.y,
+		            p.w*q.y - p.x*q.z + p.y*q.w + p.z*q.x,
+		            p.w*q.z + p.x*q.y - p.y*q.x + p.z*q.w);
+	}
+};